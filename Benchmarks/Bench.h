@@ -0,0 +1,59 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <algorithm>
+#include <functional>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+// A minimal timing harness for the engine's hot loops. Each benchmark file
+// registers its runs with a static Bench::Registration; the runner calls
+// every one whose name contains the filter given on the command line.
+namespace Bench
+{
+    struct Benchmark
+    {
+        const char* name;
+        void (*run)();
+    };
+
+    inline std::vector<Benchmark>& getRegistry()
+    {
+        static std::vector<Benchmark> registry;
+        return registry;
+    }
+
+    struct Registration
+    {
+        Registration(const char* name, void (*run)()) { getRegistry().push_back({ name, run }); }
+    };
+
+    // Seconds for one call of work: one untimed warm-up, then the best of `runs`
+    inline double time(const std::function<void()>& work, int runs = 5)
+    {
+        work();
+
+        double best = std::numeric_limits<double>::max();
+        for (int run = 0; run < runs; ++run)
+        {
+            auto start = juce::Time::getHighResolutionTicks();
+            work();
+            best = std::min(best, juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - start));
+        }
+
+        return best;
+    }
+
+    // One line of results: total time, and time per unit of work
+    inline void report(const juce::String& label, double seconds, double units, const juce::String& unitName)
+    {
+        std::cout << label.paddedRight(' ', 44) << juce::String(seconds * 1.0e3, 3).paddedLeft(' ', 10) << " ms"
+                  << juce::String(seconds * 1.0e9 / std::max(units, 1.0), 2).paddedLeft(' ', 12) << " ns/" << unitName
+                  << std::endl;
+    }
+
+    // Results are summed in here so the optimiser can't drop the work
+    inline volatile float sink = 0.0f;
+    inline void keep(float value) { sink = sink + value; }
+}
@@ -0,0 +1,17 @@
+#include "Bench.h"
+
+int main(int argc, char* argv[])
+{
+    juce::String filter = argc > 1 ? juce::String(argv[1]) : juce::String();
+
+    for (const auto& benchmark : Bench::getRegistry())
+    {
+        if (filter.isNotEmpty() && !juce::String(benchmark.name).containsIgnoreCase(filter))
+            continue;
+
+        std::cout << "== " << benchmark.name << std::endl;
+        benchmark.run();
+    }
+
+    return 0;
+}
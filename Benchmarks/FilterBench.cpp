@@ -0,0 +1,49 @@
+#include "Bench.h"
+#include "DSP/SVFilter.h"
+
+// Slot filter cost per stereo frame for each type, with the cutoff swept
+// once per 32-sample control tick as a voice does
+static void runFilterBenchmark()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int numFrames = 48000;
+    constexpr int controlInterval = 32;
+
+    std::vector<float> noise(2 * numFrames);
+    juce::Random random(1);
+    for (auto& sample : noise)
+        sample = random.nextFloat() * 2.0f - 1.0f;
+
+    const std::pair<SVFilter::Type, const char*> types[] {
+        { SVFilter::Type::LowPass, "low pass (SVF)" },
+        { SVFilter::Type::HighPass, "high pass (SVF)" },
+        { SVFilter::Type::BandPass, "band pass (SVF)" },
+        { SVFilter::Type::Ladder, "ladder (2x half-band oversampled)" }
+    };
+
+    for (const auto& [type, name] : types)
+    {
+        SVFilter filter;
+        filter.prepare(sampleRate);
+
+        auto render = [&]
+        {
+            float sum = 0.0f;
+            for (int i = 0; i < numFrames; ++i)
+            {
+                if (i % controlInterval == 0)
+                    filter.setParameters(type, 200.0f + 8000.0f * static_cast<float>(i) / numFrames, 0.7f);
+
+                float left = noise[static_cast<size_t>(2 * i)];
+                float right = noise[static_cast<size_t>(2 * i + 1)];
+                filter.process(left, right);
+                sum += left + right;
+            }
+            Bench::keep(sum);
+        };
+
+        Bench::report(juce::String("filter, ") + name, Bench::time(render), numFrames, "frame");
+    }
+}
+
+static Bench::Registration filterBenchmark { "filter", runFilterBenchmark };
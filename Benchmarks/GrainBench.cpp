@@ -0,0 +1,54 @@
+#include "Bench.h"
+#include "Sampler/GrainPlayer.h"
+#include "Sampler/SampleSlot.h"
+
+// CPU per grain: a looping 10 s stereo sample played with dense enough
+// grains to keep a given number overlapping, in 32-sample control chunks
+static void runGrainBenchmark()
+{
+    constexpr double sampleRate = 48000.0;
+    constexpr int chunkSize = 32;
+    constexpr int renderSamples = 48000;
+    constexpr float grainSizeMs = 100.0f;
+
+    juce::AudioBuffer<float> audio(2, static_cast<int>(sampleRate * 10.0));
+    juce::Random random(1);
+    for (int channel = 0; channel < audio.getNumChannels(); ++channel)
+        for (int i = 0; i < audio.getNumSamples(); ++i)
+            audio.setSample(channel, i, random.nextFloat() * 2.0f - 1.0f);
+
+    SampleSlot::InterleavedBuffer interleaved;
+    interleaved.build(audio);
+
+    GrainPlayer::Source source { audio.getReadPointer(0), audio.getReadPointer(1), interleaved.frames(),
+                                 0, 1, audio.getNumSamples() - 1, audio.getNumSamples(), true };
+
+    std::array<float, chunkSize> outL {};
+    std::array<float, chunkSize> outR {};
+
+    for (int overlap : { 1, 4, 16, 32 })
+    {
+        GrainPlayer player;
+        player.prepare(sampleRate);
+        player.setParameters(grainSizeMs, static_cast<float>(overlap) * 1000.0f / grainSizeMs, 1.0f);
+
+        double grainSamples = 0.0;
+        auto render = [&]
+        {
+            grainSamples = 0.0;
+            for (int done = 0; done < renderSamples; done += chunkSize)
+            {
+                outL.fill(0.0f);
+                outR.fill(0.0f);
+                player.render(source, 1.0f, outL.data(), outR.data(), chunkSize);
+                grainSamples += static_cast<double>(player.getNumActiveGrains()) * chunkSize;
+                Bench::keep(outL[0] + outR[chunkSize - 1]);
+            }
+        };
+
+        double seconds = Bench::time(render);
+        Bench::report("granular, " + juce::String(overlap) + " overlapping grains", seconds, grainSamples, "grain-sample");
+    }
+}
+
+static Bench::Registration grainBenchmark { "granular", runGrainBenchmark };
@@ -0,0 +1,36 @@
+#include "Bench.h"
+#include "DSP/ModMatrix.h"
+
+// Cost of one control tick's routing evaluation, and how it grows with each
+// routing slot in use
+static void runModMatrixBenchmark()
+{
+    constexpr int numTicks = 1 << 20;
+
+    for (int numRoutings = 0; numRoutings <= ModMatrix::MAX_ROUTINGS; ++numRoutings)
+    {
+        ModMatrix matrix;
+        for (int i = 0; i < numRoutings; ++i)
+            matrix.add(i % ModMatrix::NumSources, i % ModMatrix::NumDestinations, 0.1f * static_cast<float>(i + 1));
+
+        auto evaluate = [&]
+        {
+            ModMatrix::Sources sources {};
+            ModMatrix::Destinations destinations {};
+            float sum = 0.0f;
+
+            for (int tick = 0; tick < numTicks; ++tick)
+            {
+                sources[ModMatrix::Lfo] = static_cast<float>(tick & 255) * (1.0f / 128.0f) - 1.0f;
+                sources[ModMatrix::Envelope] = static_cast<float>(tick & 1023) * (1.0f / 1024.0f);
+                matrix.evaluate(sources, destinations);
+                sum += destinations[ModMatrix::Volume] + destinations[ModMatrix::Cutoff];
+            }
+            Bench::keep(sum);
+        };
+
+        Bench::report("mod matrix, " + juce::String(numRoutings) + " routings", Bench::time(evaluate), numTicks, "tick");
+    }
+}
+
+static Bench::Registration modMatrixBenchmark { "modmatrix", runModMatrixBenchmark };
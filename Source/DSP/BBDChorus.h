@@ -3,15 +3,18 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include "BlockSmoothing.h"
+#include "ParameterRamp.h"
 
 class BBDChorus
 {
 public:
     BBDChorus() = default;
 
-    void prepare(double newSampleRate, int /*maxBlockSize*/)
+    void prepare(double newSampleRate, int maxBlockSize)
     {
         sampleRate = newSampleRate;
+        mixRamp.prepare(sampleRate, maxBlockSize);
 
         // Max delay of 50ms for chorus
         int maxDelaySamples = static_cast<int>(sampleRate * 0.05);
@@ -24,6 +27,12 @@ public:
         lfoPhaseL = 0.0;
         lfoPhaseR = 0.25; // 90 degree offset for stereo
 
+        // Rate-dependent scale factors
+        samplesPerMs = static_cast<float>(sampleRate / 1000.0);
+        radiansPerHz = static_cast<float>(2.0 * 3.14159265359 / sampleRate);
+
+        coefficients.prepare(sampleRate);
+
         resetFilters();
     }
 
@@ -38,16 +47,19 @@ public:
         resetFilters();
     }
 
-    void setRate(float r) { rate = std::clamp(r, 0.01f, 10.0f); }
-    void setDepth(float d) { depth = std::clamp(d, 0.0f, 1.0f); }
-    void setMix(float m) { mix = std::clamp(m, 0.0f, 1.0f); }
-    void setTone(float t) { tone = std::clamp(t, 0.0f, 1.0f); }
+    void setRate(float r) { coefficients.set(&Params::rate, std::clamp(r, 0.01f, 10.0f)); }
+    void setDepth(float d) { coefficients.set(&Params::depth, std::clamp(d, 0.0f, 1.0f)); }
+    void setMix(float m) { mixRamp.setTarget(std::clamp(m, 0.0f, 1.0f)); }
+    void setTone(float t) { coefficients.set(&Params::tone, std::clamp(t, 0.0f, 1.0f)); }
 
     void processBlock(float* left, float* right, int numSamples)
     {
         if (delayBufferL.empty() || delayBufferR.empty())
             return;
 
+        const auto& c = coefficients.update(numSamples);
+        const float* mix = mixRamp.fill(numSamples);
+
         for (int i = 0; i < numSamples; ++i)
         {
             // Sanitize input
@@ -57,24 +69,23 @@ public:
             float lfoL = static_cast<float>(std::sin(2.0 * 3.14159265359 * lfoPhaseL));
             float lfoR = static_cast<float>(std::sin(2.0 * 3.14159265359 * lfoPhaseR));
 
-            lfoPhaseL += rate / sampleRate;
-            lfoPhaseR += rate / sampleRate;
+            lfoPhaseL += c.phaseIncrement;
+            lfoPhaseR += c.phaseIncrement;
             if (lfoPhaseL >= 1.0) lfoPhaseL -= 1.0;
             if (lfoPhaseR >= 1.0) lfoPhaseR -= 1.0;
 
             // === DELAY TIME CALCULATION ===
             // Base delay: 7ms, modulation range: +/- 5ms at full depth
             float baseDelayMs = 7.0f;
-            float modRangeMs = 5.0f * depth;
 
-            float delayMsL = baseDelayMs + lfoL * modRangeMs;
-            float delayMsR = baseDelayMs + lfoR * modRangeMs;
+            float delayMsL = baseDelayMs + lfoL * c.modRangeMs;
+            float delayMsR = baseDelayMs + lfoR * c.modRangeMs;
 
             delayMsL = std::clamp(delayMsL, 1.0f, 50.0f);
             delayMsR = std::clamp(delayMsR, 1.0f, 50.0f);
 
-            float delaySamplesL = (delayMsL / 1000.0f) * static_cast<float>(sampleRate);
-            float delaySamplesR = (delayMsR / 1000.0f) * static_cast<float>(sampleRate);
+            float delaySamplesL = delayMsL * samplesPerMs;
+            float delaySamplesR = delayMsR * samplesPerMs;
 
             // === BBD CLOCK RATE (for authentic coloration) ===
             // Shorter delays = higher clock rate = brighter sound
@@ -114,17 +125,16 @@ public:
             delayedR = bbdLowPassR(delayedR, bbdNyquistR);
 
             // === TONE CONTROL ===
-            float toneCutoff = 1000.0f + (tone * 15000.0f);
-            delayedL = toneLowPassL(delayedL, toneCutoff);
-            delayedR = toneLowPassR(delayedR, toneCutoff);
+            delayedL = toneLowPassL(delayedL, c.toneG);
+            delayedR = toneLowPassR(delayedR, c.toneG);
 
             // === COMPANDING: Expand ===
             float expandedL = expand(delayedL);
             float expandedR = expand(delayedR);
 
             // === MIX ===
-            float outL = left[i] * (1.0f - mix) + expandedL * mix;
-            float outR = right[i] * (1.0f - mix) + expandedR * mix;
+            float outL = left[i] + (expandedL - left[i]) * mix[i];
+            float outR = right[i] + (expandedR - right[i]) * mix[i];
 
             // Final sanitization
             left[i] = std::isfinite(outL) ? outL : left[i];
@@ -137,6 +147,40 @@ public:
     }
 
 private:
+    struct Params
+    {
+        float rate = 0.5f;  // LFO rate in Hz
+        float depth = 0.5f; // Modulation depth
+        float tone = 0.7f;  // Tone control (brightness)
+    };
+
+    // Everything the sample loop needs from the parameters
+    struct Coefficients
+    {
+        double phaseIncrement = 0.0;
+        float modRangeMs = 2.5f;
+        float toneG = 0.0f;
+
+        bool approach(const Coefficients& target, float amount)
+        {
+            bool moving = BlockSmoothing::approach(modRangeMs, target.modRangeMs, amount);
+            moving |= BlockSmoothing::approach(toneG, target.toneG, amount);
+
+            // The LFO rate only changes speed, so it can jump
+            phaseIncrement = target.phaseIncrement;
+            return moving;
+        }
+    };
+
+    static Coefficients computeCoefficients(const Params& p, double sampleRate)
+    {
+        Coefficients c;
+        c.phaseIncrement = p.rate / sampleRate;
+        c.modRangeMs = 5.0f * p.depth;
+        c.toneG = BlockSmoothing::onePoleCoefficient(1000.0f + (p.tone * 15000.0f), sampleRate);
+        return c;
+    }
+
     // === COMPANDING ===
     float compress(float x)
     {
@@ -155,9 +199,10 @@ private:
     }
 
     // === BBD LOW-PASS FILTERS (per channel) ===
+    // Cutoff follows the LFO, so g is still computed per sample
     float bbdLowPassL(float input, float cutoffHz)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
+        float omega = radiansPerHz * cutoffHz;
         float g = omega / (1.0f + omega);
         bbdLpfStateL = bbdLpfStateL + g * (input - bbdLpfStateL);
         if (!std::isfinite(bbdLpfStateL)) bbdLpfStateL = 0.0f;
@@ -166,7 +211,7 @@ private:
 
     float bbdLowPassR(float input, float cutoffHz)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
+        float omega = radiansPerHz * cutoffHz;
         float g = omega / (1.0f + omega);
         bbdLpfStateR = bbdLpfStateR + g * (input - bbdLpfStateR);
         if (!std::isfinite(bbdLpfStateR)) bbdLpfStateR = 0.0f;
@@ -174,19 +219,15 @@ private:
     }
 
     // === TONE FILTERS (per channel) ===
-    float toneLowPassL(float input, float cutoffHz)
+    float toneLowPassL(float input, float g)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
         toneLpfStateL = toneLpfStateL + g * (input - toneLpfStateL);
         if (!std::isfinite(toneLpfStateL)) toneLpfStateL = 0.0f;
         return toneLpfStateL;
     }
 
-    float toneLowPassR(float input, float cutoffHz)
+    float toneLowPassR(float input, float g)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
         toneLpfStateR = toneLpfStateR + g * (input - toneLpfStateR);
         if (!std::isfinite(toneLpfStateR)) toneLpfStateR = 0.0f;
         return toneLpfStateR;
@@ -201,10 +242,7 @@ private:
     }
 
     // Parameters
-    float rate = 0.5f;      // LFO rate in Hz
-    float depth = 0.5f;     // Modulation depth
-    float mix = 0.5f;       // Wet/dry mix
-    float tone = 0.7f;      // Tone control (brightness)
+    ParameterRamp mixRamp { ParameterRamp::Shape::Linear, 0.5f }; // Wet/dry mix, ramped per sample
 
     // State
     double sampleRate = 44100.0;
@@ -215,6 +253,10 @@ private:
     double lfoPhaseL = 0.0;
     double lfoPhaseR = 0.25;
 
+    SmoothedCoefficients<Params, Coefficients> coefficients { &BBDChorus::computeCoefficients };
+    float samplesPerMs = 44.1f;
+    float radiansPerHz = static_cast<float>(2.0 * 3.14159265359 / 44100.0);
+
     // Filter states
     float bbdLpfStateL = 0.0f;
     float bbdLpfStateR = 0.0f;
@@ -3,6 +3,8 @@
 #include <vector>
 #include <cmath>
 #include <algorithm>
+#include "BlockSmoothing.h"
+#include "ParameterRamp.h"
 
 class BBDDelay
 {
@@ -12,6 +14,7 @@ public:
     void prepare(double newSampleRate, int maxBlockSize)
     {
         sampleRate = newSampleRate;
+        mixRamp.prepare(sampleRate, maxBlockSize);
 
         // Max delay of 1 second
         int maxDelaySamples = static_cast<int>(sampleRate * 1.0);
@@ -20,6 +23,12 @@ public:
         // Initialize modulation LFO
         modPhase = 0.0;
 
+        // Rate-dependent scale factors
+        samplesPerMs = static_cast<float>(sampleRate / 1000.0);
+        radiansPerHz = static_cast<float>(2.0 * 3.14159265359 / sampleRate);
+
+        coefficients.prepare(sampleRate);
+
         // Initialize filters
         resetFilters();
     }
@@ -32,14 +41,16 @@ public:
         resetFilters();
     }
 
-    void setDelayTime(float timeMs) { delayTimeMs = std::clamp(timeMs, 1.0f, 1000.0f); }
-    void setFeedback(float fb) { feedback = std::clamp(fb, 0.0f, 0.99f); }
-    void setModDepth(float depth) { modDepth = std::clamp(depth, 0.0f, 1.0f); }
-    void setModRate(float rate) { modRate = std::clamp(rate, 0.01f, 10.0f); }
-    void setTone(float t) { tone = std::clamp(t, 0.0f, 1.0f); }
-    void setMix(float m) { mix = std::clamp(m, 0.0f, 1.0f); }
+    void setDelayTime(float timeMs) { coefficients.set(&Params::delayTimeMs, std::clamp(timeMs, 1.0f, 1000.0f)); }
+    void setFeedback(float fb) { coefficients.set(&Params::feedback, std::clamp(fb, 0.0f, 0.99f)); }
+    void setModDepth(float depth) { coefficients.set(&Params::modDepth, std::clamp(depth, 0.0f, 1.0f)); }
+    void setModRate(float rate) { coefficients.set(&Params::modRate, std::clamp(rate, 0.01f, 10.0f)); }
+    void setTone(float t) { coefficients.set(&Params::tone, std::clamp(t, 0.0f, 1.0f)); }
+    void setMix(float m) { mixRamp.setTarget(std::clamp(m, 0.0f, 1.0f)); }
 
-    float process(float input)
+    // One sample with the coefficients of the current block, and this
+    // sample's wet/dry mix and delay time
+    float process(float input, float mix, float delayTimeMs)
     {
         if (delayBuffer.empty())
             return input;
@@ -48,21 +59,23 @@ public:
         if (!std::isfinite(input))
             input = 0.0f;
 
+        const auto& c = coefficients.get();
+
         // === COMPANDING: Pre-compress input ===
         float compressedInput = compress(input);
 
         // === MODULATION: Calculate modulated delay time ===
         float lfoValue = std::sin(2.0 * 3.14159265359 * modPhase);
-        modPhase += modRate / sampleRate;
+        modPhase += c.phaseIncrement;
         if (modPhase >= 1.0)
             modPhase -= 1.0;
 
         // Modulation range: +/- 2ms at full depth
-        float modulationMs = lfoValue * modDepth * 2.0f;
+        float modulationMs = lfoValue * c.modRangeMs;
         float actualDelayMs = delayTimeMs + modulationMs;
         actualDelayMs = std::clamp(actualDelayMs, 1.0f, 1000.0f);
 
-        float delaySamples = (actualDelayMs / 1000.0f) * static_cast<float>(sampleRate);
+        float delaySamples = actualDelayMs * samplesPerMs;
 
         // === BBD CLOCK RATE CALCULATION ===
         // Real BBD: clockRate = numStages / (2 * delayTime)
@@ -95,14 +108,13 @@ public:
 
         // === TONE CONTROL (user-adjustable additional filtering) ===
         // tone 0 = dark, tone 1 = bright
-        float toneCutoff = 200.0f + (tone * 10000.0f);
-        delayedSample = toneLowPass(delayedSample, toneCutoff);
+        delayedSample = toneLowPass(delayedSample, c.toneG);
 
         // === COMPANDING: Expand output ===
         float expandedOutput = expand(delayedSample);
 
         // === FEEDBACK PATH with soft saturation ===
-        float feedbackSample = softSaturate(expandedOutput * feedback);
+        float feedbackSample = softSaturate(expandedOutput * c.feedback);
 
         // Compress feedback before writing back
         float toWrite = compressedInput + compress(feedbackSample);
@@ -117,7 +129,7 @@ public:
         writeIndex = (writeIndex + 1) % static_cast<int>(delayBuffer.size());
 
         // === MIX ===
-        float output = input * (1.0f - mix) + expandedOutput * mix;
+        float output = input + (expandedOutput - input) * mix;
 
         // Final sanitization
         if (!std::isfinite(output))
@@ -128,19 +140,69 @@ public:
 
     void processBlock(float* left, float* right, int numSamples)
     {
+        // The delay time moves the read position, so a per-block step would
+        // click; it is interpolated across the block instead
+        float delayTimeMs = coefficients.get().delayTimeMs;
+        float delayTimeStep = (coefficients.update(numSamples).delayTimeMs - delayTimeMs) / static_cast<float>(numSamples);
+        const float* mix = mixRamp.fill(numSamples);
+
         for (int i = 0; i < numSamples; ++i)
         {
+            delayTimeMs += delayTimeStep;
+
             // Process mono sum for delay, then apply to both channels
             float mono = (left[i] + right[i]) * 0.5f;
-            float delayed = process(mono);
+            float delayed = process(mono, mix[i], delayTimeMs);
 
             // Mix delayed signal back to stereo
-            left[i] = left[i] * (1.0f - mix) + delayed * mix;
-            right[i] = right[i] * (1.0f - mix) + delayed * mix;
+            left[i] += (delayed - left[i]) * mix[i];
+            right[i] += (delayed - right[i]) * mix[i];
         }
     }
 
 private:
+    struct Params
+    {
+        float delayTimeMs = 200.0f;
+        float feedback = 0.5f;
+        float modDepth = 0.0f;
+        float modRate = 1.0f;
+        float tone = 0.5f;
+    };
+
+    // Everything the sample loop needs from the parameters
+    struct Coefficients
+    {
+        float delayTimeMs = 200.0f;
+        float modRangeMs = 0.0f;
+        double phaseIncrement = 0.0;
+        float toneG = 0.0f;
+        float feedback = 0.5f;
+
+        bool approach(const Coefficients& target, float amount)
+        {
+            bool moving = BlockSmoothing::approach(delayTimeMs, target.delayTimeMs, amount);
+            moving |= BlockSmoothing::approach(modRangeMs, target.modRangeMs, amount);
+            moving |= BlockSmoothing::approach(toneG, target.toneG, amount);
+            moving |= BlockSmoothing::approach(feedback, target.feedback, amount);
+
+            // The LFO rate only changes speed, so it can jump
+            phaseIncrement = target.phaseIncrement;
+            return moving;
+        }
+    };
+
+    static Coefficients computeCoefficients(const Params& p, double sampleRate)
+    {
+        Coefficients c;
+        c.delayTimeMs = p.delayTimeMs;
+        c.modRangeMs = p.modDepth * 2.0f;
+        c.phaseIncrement = p.modRate / sampleRate;
+        c.toneG = BlockSmoothing::onePoleCoefficient(200.0f + (p.tone * 10000.0f), sampleRate);
+        c.feedback = p.feedback;
+        return c;
+    }
+
     // === COMPANDING (simulates BBD compander chips) ===
     float compress(float x)
     {
@@ -168,10 +230,11 @@ private:
     }
 
     // === BBD LOW-PASS FILTER ===
-    // Simple one-pole LPF that models the bandwidth limitation
+    // Simple one-pole LPF that models the bandwidth limitation. The cutoff
+    // follows the modulated delay, so this one is still computed per sample.
     float bbdLowPass(float input, float cutoffHz)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
+        float omega = radiansPerHz * cutoffHz;
         float g = omega / (1.0f + omega);
 
         bbdLpfState = bbdLpfState + g * (input - bbdLpfState);
@@ -184,11 +247,8 @@ private:
     }
 
     // === TONE LOW-PASS FILTER ===
-    float toneLowPass(float input, float cutoffHz)
+    float toneLowPass(float input, float g)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
-
         toneLpfState = toneLpfState + g * (input - toneLpfState);
 
         // Protect filter state from corruption
@@ -205,12 +265,7 @@ private:
     }
 
     // Parameters
-    float delayTimeMs = 200.0f;
-    float feedback = 0.5f;
-    float modDepth = 0.0f;
-    float modRate = 1.0f;
-    float tone = 0.5f;
-    float mix = 0.5f;
+    ParameterRamp mixRamp { ParameterRamp::Shape::Linear, 0.5f }; // ramped per sample
 
     // State
     double sampleRate = 44100.0;
@@ -218,6 +273,10 @@ private:
     int writeIndex = 0;
     double modPhase = 0.0;
 
+    SmoothedCoefficients<Params, Coefficients> coefficients { &BBDDelay::computeCoefficients };
+    float samplesPerMs = 44.1f;
+    float radiansPerHz = static_cast<float>(2.0 * 3.14159265359 / 44100.0);
+
     // Filter states
     float bbdLpfState = 0.0f;
     float toneLpfState = 0.0f;
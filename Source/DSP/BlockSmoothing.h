@@ -0,0 +1,101 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+// Effects cache everything derived from their parameters in a coefficient
+// struct (SmoothedCoefficients below) that is only rebuilt when a setter
+// changes a value or the sample rate changes. The values in use then move
+// towards the rebuilt ones once per block rather than jumping.
+namespace BlockSmoothing
+{
+    constexpr double SMOOTHING_SECONDS = 0.02;
+
+    // One-pole step for a block of numSamples
+    inline float blockAmount(int numSamples, double sampleRate)
+    {
+        return static_cast<float>(1.0 - std::exp(-numSamples / (sampleRate * SMOOTHING_SECONDS)));
+    }
+
+    // Moves current towards target; returns true while it hasn't arrived
+    inline bool approach(float& current, float target, float amount)
+    {
+        float difference = target - current;
+        if (std::abs(difference) <= 1.0e-5f * std::max(1.0f, std::abs(target)))
+        {
+            current = target;
+            return false;
+        }
+
+        current += amount * difference;
+        return true;
+    }
+
+    // 2*pi*fc/fs mapped to a one-pole low-pass coefficient
+    inline float onePoleCoefficient(float cutoffHz, double sampleRate)
+    {
+        float omega = static_cast<float>(2.0 * 3.14159265359 * cutoffHz / sampleRate);
+        return omega / (1.0f + omega);
+    }
+}
+
+// An effect's parameters and the coefficients derived from them. The target
+// coefficients are rebuilt by `compute` when a parameter or the rate
+// changes; the current ones follow once per block through
+// Coeffs::approach(target, amount), which returns true while still moving.
+template <typename Params, typename Coeffs>
+class SmoothedCoefficients
+{
+public:
+    using Compute = Coeffs (*)(const Params&, double sampleRate);
+
+    explicit SmoothedCoefficients(Compute computeFunction) : compute(computeFunction) {}
+
+    // Jumps straight to the coefficients for the new rate
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        target = compute(params, sampleRate);
+        current = target;
+        dirty = false;
+        smoothing = false;
+    }
+
+    const Params& getParams() const { return params; }
+
+    void set(float Params::* parameter, float value)
+    {
+        if (params.*parameter != value)
+        {
+            params.*parameter = value;
+            dirty = true;
+        }
+    }
+
+    // Once at the top of each block
+    const Coeffs& update(int numSamples)
+    {
+        if (dirty)
+        {
+            target = compute(params, sampleRate);
+            dirty = false;
+            smoothing = true;
+        }
+
+        if (smoothing)
+            smoothing = current.approach(target, BlockSmoothing::blockAmount(numSamples, sampleRate));
+
+        return current;
+    }
+
+    const Coeffs& get() const { return current; }
+
+private:
+    Compute compute;
+    Params params;
+    Coeffs target;
+    Coeffs current;
+    double sampleRate = 44100.0;
+    bool dirty = true;
+    bool smoothing = false;
+};
@@ -0,0 +1,320 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <array>
+#include <algorithm>
+#include <cstdint>
+#include <numeric>
+#include "BBDDelay.h"
+#include "BBDChorus.h"
+#include "TapeSaturation.h"
+#include "SpectralFilter.h"
+#include "ParameterRamp.h"
+#include "../Utils/EffectOrder.h"
+
+// The global effects as a small graph: in series in any order, or as
+// parallel branches that each take the chain's input and are summed with a
+// gain per branch. The effects are owned here and never reallocated; a
+// topology is only their order and branch gains (set and processed on the
+// audio thread). Branch gains glide to new values. A new order or mode
+// can't be crossfaded against the old one directly, since both would run
+// the same stateful effects, so the chain's output fades to its input over
+// a few ms, the topology switches, and it fades back in.
+//
+// Parallel branches share one dry copy and one branch buffer: each branch
+// adds gain * (branch - dry) to the output, so a parallel chain runs every
+// effect once, like a serial one, plus a few vector copies.
+//
+// Bypassing an effect fades it out over a few ms rather than cutting it,
+// after which it isn't processed at all and its state is left frozen. When
+// it's enabled again that state is cleared first, so old delay lines don't
+// come back with it, and it fades in from silence.
+class EffectChain
+{
+public:
+    using enum EffectOrder::Effect;
+    using Effect = EffectOrder::Effect;
+    using Order = EffectOrder::Order;
+
+    enum class Mode
+    {
+        Serial,
+        Parallel
+    };
+
+    struct Topology
+    {
+        Mode mode = Mode::Serial;
+        Order order = EffectOrder::DEFAULT_ORDER;
+        std::array<float, NumEffects> branchGains { 1.0f, 1.0f, 1.0f, 1.0f };
+
+        bool operator==(const Topology&) const = default;
+    };
+
+    static constexpr double BYPASS_FADE_SECONDS = 0.005;
+
+    // Each way, out to the input and back in
+    static constexpr double TOPOLOGY_FADE_SECONDS = 0.005;
+
+    void prepare(double sampleRate, int maxBlockSize)
+    {
+        delay.prepare(sampleRate, maxBlockSize);
+        chorus.prepare(sampleRate, maxBlockSize);
+        tape.prepare(sampleRate, maxBlockSize);
+        spectral.prepare(sampleRate, maxBlockSize);
+
+        dryScratch.setSize(2, maxBlockSize);
+        branchScratch.setSize(2, maxBlockSize);
+        inputScratch.setSize(2, maxBlockSize);
+
+        // Each effect starts fully in or out, without fading at the first block
+        for (auto& fade : fades)
+            fade.prepare(sampleRate, maxBlockSize, BYPASS_FADE_SECONDS);
+
+        for (auto& gain : branchGains)
+            gain.prepare(sampleRate, maxBlockSize);
+
+        // Nothing is playing yet, so a pending topology needn't fade
+        if (hasPendingTopology)
+        {
+            topology = pendingTopology;
+            hasPendingTopology = false;
+        }
+
+        topologyFade.setTarget(1.0f);
+        topologyFade.prepare(sampleRate, maxBlockSize, TOPOLOGY_FADE_SECONDS);
+    }
+
+    BBDDelay& getDelay() { return delay; }
+    BBDChorus& getChorus() { return chorus; }
+    TapeSaturation& getTape() { return tape; }
+    SpectralFilter& getSpectral() { return spectral; }
+
+    // Takes effect from the next process(): branch gains glide there, and a
+    // new order or mode is faded to. An order that isn't a permutation of
+    // the effects falls back to the default.
+    void setTopology(const Topology& newTopology)
+    {
+        Topology validated = newTopology;
+
+        Order sorted = validated.order;
+        std::sort(sorted.begin(), sorted.end());
+        Order identity {};
+        std::iota(identity.begin(), identity.end(), std::uint8_t { 0 });
+
+        if (sorted != identity)
+            validated.order = identity;
+
+        for (size_t i = 0; i < branchGains.size(); ++i)
+            branchGains[i].setTarget(validated.branchGains[i]);
+
+        // Back to the topology in use, if a switch away from it hasn't happened yet
+        hasPendingTopology = validated.mode != topology.mode || validated.order != topology.order;
+        if (hasPendingTopology)
+            pendingTopology = validated;
+        else
+            topology = validated;
+
+        topologyFade.setTarget(hasPendingTopology ? 0.0f : 1.0f);
+    }
+
+    // The topology being played, until a pending one has faded in
+    const Topology& getTopology() const { return topology; }
+
+    // === BYPASS ===
+    // Starts the effect fading in or out from the next process()
+    void setEnabled(int effect, bool isEnabled)
+    {
+        if (effect < 0 || effect >= NumEffects)
+            return;
+
+        auto index = static_cast<size_t>(effect);
+        auto& fade = fades[index];
+
+        // Warm restart: an effect coming back from full bypass drops the
+        // state it froze with
+        if (isEnabled && !enabled[index] && !fade.isRamping() && fade.getCurrent() == 0.0f)
+            resetEffect(effect);
+
+        enabled[index] = isEnabled;
+        fade.setTarget(isEnabled ? 1.0f : 0.0f);
+    }
+
+    bool isEnabled(int effect) const
+    {
+        return effect >= 0 && effect < NumEffects && enabled[static_cast<size_t>(effect)];
+    }
+
+    // True while the effect is processed: enabled, or still fading out
+    bool isRunning(int effect) const
+    {
+        if (effect < 0 || effect >= NumEffects)
+            return false;
+
+        auto index = static_cast<size_t>(effect);
+        return enabled[index] || fades[index].isRamping();
+    }
+
+    void process(float* left, float* right, int numSamples)
+    {
+        numSamples = std::min(numSamples, dryScratch.getNumSamples());
+
+        // Faded all the way out: switch, and fade back in
+        if (hasPendingTopology && !topologyFade.isRamping())
+        {
+            topology = pendingTopology;
+            hasPendingTopology = false;
+            topologyFade.setTarget(1.0f);
+        }
+
+        if (!topologyFade.isRamping() && topologyFade.getCurrent() == 1.0f)
+        {
+            processTopology(left, right, numSamples);
+            return;
+        }
+
+        auto* inputL = inputScratch.getWritePointer(0);
+        auto* inputR = inputScratch.getWritePointer(1);
+        juce::FloatVectorOperations::copy(inputL, left, numSamples);
+        juce::FloatVectorOperations::copy(inputR, right, numSamples);
+
+        processTopology(left, right, numSamples);
+
+        const float* fade = topologyFade.fill(numSamples);
+        crossfade(left, inputL, fade, numSamples);
+        crossfade(right, inputR, fade, numSamples);
+    }
+
+private:
+    void processTopology(float* left, float* right, int numSamples)
+    {
+        auto* dryL = dryScratch.getWritePointer(0);
+        auto* dryR = dryScratch.getWritePointer(1);
+
+        if (topology.mode == Mode::Serial)
+        {
+            for (auto effect : topology.order)
+            {
+                if (!isRunning(effect))
+                    continue;
+
+                if (!fades[effect].isRamping())
+                {
+                    processEffect(effect, left, right, numSamples);
+                    continue;
+                }
+
+                // dry + fade * (wet - dry)
+                juce::FloatVectorOperations::copy(dryL, left, numSamples);
+                juce::FloatVectorOperations::copy(dryR, right, numSamples);
+                processEffect(effect, left, right, numSamples);
+
+                const float* fade = fades[effect].fill(numSamples);
+                crossfade(left, dryL, fade, numSamples);
+                crossfade(right, dryR, fade, numSamples);
+            }
+            return;
+        }
+
+        if (std::none_of(topology.order.begin(), topology.order.end(), [this](auto e) { return isRunning(e); }))
+            return;
+
+        auto* branchL = branchScratch.getWritePointer(0);
+        auto* branchR = branchScratch.getWritePointer(1);
+
+        juce::FloatVectorOperations::copy(dryL, left, numSamples);
+        juce::FloatVectorOperations::copy(dryR, right, numSamples);
+
+        // dry + sum of gain * fade * (branch - dry)
+        for (auto effect : topology.order)
+        {
+            if (!isRunning(effect))
+                continue;
+
+            juce::FloatVectorOperations::copy(branchL, dryL, numSamples);
+            juce::FloatVectorOperations::copy(branchR, dryR, numSamples);
+            processEffect(effect, branchL, branchR, numSamples);
+
+            juce::FloatVectorOperations::subtract(branchL, branchL, dryL, numSamples);
+            juce::FloatVectorOperations::subtract(branchR, branchR, dryR, numSamples);
+
+            if (fades[effect].isRamping())
+            {
+                const float* fade = fades[effect].fill(numSamples);
+                juce::FloatVectorOperations::multiply(branchL, fade, numSamples);
+                juce::FloatVectorOperations::multiply(branchR, fade, numSamples);
+            }
+
+            auto& gain = branchGains[effect];
+            if (gain.isRamping())
+            {
+                const float* gains = gain.fill(numSamples);
+                juce::FloatVectorOperations::multiply(branchL, gains, numSamples);
+                juce::FloatVectorOperations::multiply(branchR, gains, numSamples);
+                juce::FloatVectorOperations::add(left, branchL, numSamples);
+                juce::FloatVectorOperations::add(right, branchR, numSamples);
+            }
+            else
+            {
+                juce::FloatVectorOperations::addWithMultiply(left, branchL, gain.getCurrent(), numSamples);
+                juce::FloatVectorOperations::addWithMultiply(right, branchR, gain.getCurrent(), numSamples);
+            }
+        }
+    }
+
+    // wet = dry + fade * (wet - dry), in place
+    static void crossfade(float* wet, const float* dry, const float* fade, int numSamples)
+    {
+        juce::FloatVectorOperations::subtract(wet, wet, dry, numSamples);
+        juce::FloatVectorOperations::multiply(wet, fade, numSamples);
+        juce::FloatVectorOperations::add(wet, dry, numSamples);
+    }
+
+    void resetEffect(int effect)
+    {
+        switch (effect)
+        {
+            case Delay:    delay.reset(); break;
+            case Chorus:   chorus.reset(); break;
+            case Tape:     tape.reset(); break;
+            case Spectral: spectral.reset(); break;
+            default:       break;
+        }
+    }
+
+    void processEffect(int effect, float* left, float* right, int numSamples)
+    {
+        switch (effect)
+        {
+            case Delay:    delay.processBlock(left, right, numSamples); break;
+            case Chorus:   chorus.processBlock(left, right, numSamples); break;
+            case Tape:     tape.processBlock(left, right, numSamples); break;
+            case Spectral: spectral.processBlock(left, right, numSamples); break;
+            default:       break;
+        }
+    }
+
+    BBDDelay delay;
+    BBDChorus chorus;
+    TapeSaturation tape;
+    SpectralFilter spectral;
+
+    Topology topology;
+    Topology pendingTopology;
+    bool hasPendingTopology = false;
+    ParameterRamp topologyFade { ParameterRamp::Shape::Linear, 1.0f };
+    std::array<ParameterRamp, NumEffects> branchGains { ParameterRamp { ParameterRamp::Shape::Linear, 1.0f },
+                                                        ParameterRamp { ParameterRamp::Shape::Linear, 1.0f },
+                                                        ParameterRamp { ParameterRamp::Shape::Linear, 1.0f },
+                                                        ParameterRamp { ParameterRamp::Shape::Linear, 1.0f } };
+
+    std::array<bool, NumEffects> enabled { true, true, true, true };
+    std::array<ParameterRamp, NumEffects> fades { ParameterRamp { ParameterRamp::Shape::Linear, 1.0f },
+                                                  ParameterRamp { ParameterRamp::Shape::Linear, 1.0f },
+                                                  ParameterRamp { ParameterRamp::Shape::Linear, 1.0f },
+                                                  ParameterRamp { ParameterRamp::Shape::Linear, 1.0f } };
+
+    juce::AudioBuffer<float> dryScratch;
+    juce::AudioBuffer<float> branchScratch;
+    juce::AudioBuffer<float> inputScratch; // the chain's input, while fading between topologies
+};
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+
+namespace FastMath
+{
+    // === FAST EXP2 ===
+    // Splits x into integer and fractional parts: the integer part goes
+    // straight into the float exponent, the fractional part uses a 6th order
+    // polynomial for 2^f on [0, 1). Relative error is below 1e-5, which is
+    // under 0.02 cents when used for pitch ratios.
+    inline float exp2(float x)
+    {
+        x = std::clamp(x, -126.0f, 126.0f);
+
+        float whole = std::floor(x);
+        float f = x - whole;
+
+        float p = 1.0f + f * (0.69314718f
+                       + f * (0.24022650f
+                       + f * (0.05550411f
+                       + f * (0.00961813f
+                       + f * (0.00133336f
+                       + f * 0.00015404f)))));
+
+        std::int32_t bits;
+        std::memcpy(&bits, &p, sizeof(bits));
+        bits += static_cast<std::int32_t>(whole) << 23;
+        std::memcpy(&p, &bits, sizeof(p));
+
+        return p;
+    }
+
+    // Semitone offset to playback ratio
+    inline float semitonesToRatio(float semitones)
+    {
+        return exp2(semitones * (1.0f / 12.0f));
+    }
+
+    // === POLYNOMIAL SATURATION ===
+    // tanh-like odd cubic: unity slope at zero, reaching exactly +-1 with zero
+    // slope at +-1.5 and hard-limited beyond. No divide and no transcendental.
+    inline float tanhApprox(float x)
+    {
+        x = std::clamp(x, -1.5f, 1.5f);
+        return x - (4.0f / 27.0f) * x * x * x;
+    }
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <array>
+
+// Stereo 2x up/downsampler for per-sample processing (the ladder filter),
+// built on a 31-tap polyphase half-band FIR (Kaiser window, beta 6). It is
+// flat within 0.01 dB up to 0.36 of the base rate and at least 60 dB down
+// from 0.64, so the upsampler's images and the oversampled stage's
+// harmonics above the base Nyquist are removed before they fold back.
+//
+// Every other tap of a half-band is zero and the centre tap is 0.5, so each
+// direction is one 16-tap dot product per base-rate frame plus a plain
+// delay. Latency is 15 base-rate samples for the round trip.
+class HalfBandOversampler
+{
+public:
+    using Frame = std::array<float, 2>;
+
+    static constexpr int LATENCY = 15;
+
+    void reset()
+    {
+        for (auto* history : { &input, &evenOutput, &oddOutput })
+            *history = {};
+    }
+
+    // One base-rate frame in, two oversampled frames out (in time order)
+    void upsample(const Frame& frame, Frame& first, Frame& second)
+    {
+        for (size_t c = 0; c < 2; ++c)
+        {
+            input[c].push(frame[c]);
+            first[c] = 2.0f * input[c].dot(TAPS);
+            second[c] = input[c].at(CENTRE_DELAY);
+        }
+    }
+
+    // Feeds the upsampler's history without producing output, so switching
+    // to oversampled processing starts from the real recent input
+    void prime(const Frame& frame)
+    {
+        for (size_t c = 0; c < 2; ++c)
+            input[c].push(frame[c]);
+    }
+
+    // Two oversampled frames in (in time order), one base-rate frame out
+    void downsample(const Frame& first, const Frame& second, Frame& frame)
+    {
+        for (size_t c = 0; c < 2; ++c)
+        {
+            evenOutput[c].push(first[c]);
+            oddOutput[c].push(second[c]);
+            frame[c] = 0.5f * evenOutput[c].at(CENTRE_DELAY) + oddOutput[c].dot(TAPS);
+        }
+    }
+
+private:
+    static constexpr int NUM_TAPS = 16;
+    static constexpr int CENTRE_DELAY = NUM_TAPS / 2 - 1;
+
+    // The nonzero side taps (even indices of the full filter), summing to 0.5
+    static constexpr std::array<float, NUM_TAPS> TAPS {
+        -3.1558913595e-04f, 1.7677191245e-03f, -5.2087344444e-03f, 1.1989061905e-02f,
+        -2.4251087068e-02f, 4.6589055325e-02f, -9.4995013044e-02f, 3.1442458734e-01f,
+        3.1442458734e-01f, -9.4995013044e-02f, 4.6589055325e-02f, -2.4251087068e-02f,
+        1.1989061905e-02f, -5.2087344444e-03f, 1.7677191245e-03f, -3.1558913595e-04f
+    };
+
+    // Last NUM_TAPS values of one phase, newest first. Each value is stored
+    // twice, NUM_TAPS apart, so the window is always contiguous.
+    struct History
+    {
+        std::array<float, 2 * NUM_TAPS> values {};
+        int position = 0;
+
+        void push(float value)
+        {
+            position = (position == 0 ? NUM_TAPS : position) - 1;
+            values[static_cast<size_t>(position)] = value;
+            values[static_cast<size_t>(position + NUM_TAPS)] = value;
+        }
+
+        // The value `age` pushes ago (0 = newest)
+        float at(int age) const { return values[static_cast<size_t>(position + age)]; }
+
+        float dot(const std::array<float, NUM_TAPS>& taps) const
+        {
+            const float* window = values.data() + position;
+            float sum = 0.0f;
+            for (int k = 0; k < NUM_TAPS; ++k)
+                sum += taps[static_cast<size_t>(k)] * window[k];
+            return sum;
+        }
+    };
+
+    std::array<History, 2> input;
+    std::array<History, 2> evenOutput;
+    std::array<History, 2> oddOutput;
+};
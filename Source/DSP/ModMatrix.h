@@ -0,0 +1,87 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+// Per-slot modulation routing. The user's rows (source, destination, amount)
+// are compiled into a flat list of routings that skips unused rows, so a
+// voice evaluates it once per control tick as a straight multiply-add loop
+// over plain arrays.
+//
+// Sources are normalised: LFO and note -1..1, the rest 0..1. Destinations
+// come out as the sum of source x amount for each routing that targets
+// them; what a unit of each means is up to the voice.
+class ModMatrix
+{
+public:
+    enum Source
+    {
+        Lfo,
+        Velocity,
+        Envelope,
+        Note,
+        ModWheel,
+        NumSources
+    };
+
+    enum Destination
+    {
+        Cutoff,
+        Pitch,
+        Volume,
+        Pan,
+        InPoint,
+        NumDestinations
+    };
+
+    // User rows plus the built-in LFO depth -> cutoff routing
+    static constexpr int MAX_ROUTINGS = 8;
+
+    using Sources = std::array<float, NumSources>;
+    using Destinations = std::array<float, NumDestinations>;
+
+    struct Routing
+    {
+        std::uint8_t source = 0;
+        std::uint8_t destination = 0;
+        float amount = 0.0f;
+    };
+
+    void clear()
+    {
+        numRoutings = 0;
+        destinationMask = 0;
+    }
+
+    // Out-of-range or zero-amount routings are dropped
+    void add(int source, int destination, float amount)
+    {
+        if (source < 0 || source >= NumSources || destination < 0 || destination >= NumDestinations
+            || amount == 0.0f || numRoutings == MAX_ROUTINGS)
+            return;
+
+        routings[static_cast<size_t>(numRoutings++)] = { static_cast<std::uint8_t>(source),
+                                                         static_cast<std::uint8_t>(destination), amount };
+        destinationMask |= 1u << destination;
+    }
+
+    void evaluate(const Sources& sources, Destinations& destinations) const
+    {
+        destinations.fill(0.0f);
+
+        for (int i = 0; i < numRoutings; ++i)
+        {
+            const auto& routing = routings[static_cast<size_t>(i)];
+            destinations[routing.destination] += sources[routing.source] * routing.amount;
+        }
+    }
+
+    bool isEmpty() const { return numRoutings == 0; }
+    bool targets(Destination destination) const { return (destinationMask & (1u << destination)) != 0; }
+    int getNumRoutings() const { return numRoutings; }
+
+private:
+    std::array<Routing, MAX_ROUTINGS> routings {};
+    int numRoutings = 0;
+    std::uint32_t destinationMask = 0;
+};
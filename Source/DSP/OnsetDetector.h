@@ -0,0 +1,149 @@
+#pragma once
+
+#include <juce_dsp/juce_dsp.h>
+#include <vector>
+#include <cmath>
+#include <algorithm>
+
+// Offline transient detection by spectral flux: the summed rise in (log)
+// magnitude per bin between consecutive FFT frames, peak-picked against a
+// moving average. Window, difference and rectification are vector ops.
+class OnsetDetector
+{
+public:
+    static constexpr int FFT_ORDER = 10;
+    static constexpr int FFT_SIZE = 1 << FFT_ORDER;
+    static constexpr int HOP_SIZE = FFT_SIZE / 4;
+
+    // Onset positions in samples, ascending and at least minGapSeconds apart.
+    // Higher sensitivity (0-1) lowers the threshold and finds softer hits.
+    static std::vector<int> detect(const float* mono, int numSamples, double sampleRate,
+                                   float sensitivity = 0.5f, double minGapSeconds = 0.05)
+    {
+        std::vector<int> onsets;
+        if (mono == nullptr || numSamples < FFT_SIZE)
+            return onsets;
+
+        auto flux = computeFlux(mono, numSamples);
+
+        // Normalise so the threshold doesn't depend on level
+        float peak = *std::max_element(flux.begin(), flux.end());
+        if (peak <= 0.0f)
+            return onsets;
+
+        juce::FloatVectorOperations::multiply(flux.data(), 1.0f / peak, static_cast<int>(flux.size()));
+
+        const int numFrames = static_cast<int>(flux.size());
+        const int minGap = static_cast<int>(minGapSeconds * sampleRate);
+        const float delta = 0.05f + 0.4f * (1.0f - std::clamp(sensitivity, 0.0f, 1.0f));
+        int lastOnset = -minGap;
+
+        for (int i = 1; i < numFrames; ++i)
+        {
+            // Local maximum over +-2 frames, above the local mean plus delta
+            bool isPeak = true;
+            for (int j = std::max(0, i - 2); j <= std::min(numFrames - 1, i + 2) && isPeak; ++j)
+                isPeak = flux[static_cast<size_t>(j)] <= flux[static_cast<size_t>(i)];
+
+            if (!isPeak)
+                continue;
+
+            float mean = 0.0f;
+            int first = std::max(0, i - MEAN_FRAMES);
+            int last = std::min(numFrames - 1, i + MEAN_FRAMES);
+            for (int j = first; j <= last; ++j)
+                mean += flux[static_cast<size_t>(j)];
+            mean /= static_cast<float>(last - first + 1);
+
+            if (flux[static_cast<size_t>(i)] < mean + delta)
+                continue;
+
+            int position = refine(mono, numSamples, i);
+            if (position - lastOnset >= minGap)
+            {
+                onsets.push_back(position);
+                lastOnset = position;
+            }
+        }
+
+        return onsets;
+    }
+
+private:
+    static constexpr int MEAN_FRAMES = 8;
+    static constexpr int ENERGY_BLOCK = 64;
+
+    // Frame i covers samples [i * HOP_SIZE, i * HOP_SIZE + FFT_SIZE)
+    static std::vector<float> computeFlux(const float* mono, int numSamples)
+    {
+        constexpr int numBins = FFT_SIZE / 2 + 1;
+
+        juce::dsp::FFT fft(FFT_ORDER);
+        std::vector<float> window(FFT_SIZE);
+        for (int i = 0; i < FFT_SIZE; ++i)
+            window[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * static_cast<float>(i) / FFT_SIZE);
+
+        std::vector<float> frame(2 * FFT_SIZE);
+        std::vector<float> previous(numBins, 0.0f);
+        std::vector<float> rise(numBins);
+        std::vector<float> flux;
+
+        for (int start = 0; start + HOP_SIZE <= numSamples; start += HOP_SIZE)
+        {
+            int count = std::min(FFT_SIZE, numSamples - start);
+            std::fill(frame.begin(), frame.end(), 0.0f);
+            juce::FloatVectorOperations::multiply(frame.data(), mono + start, window.data(), count);
+
+            fft.performFrequencyOnlyForwardTransform(frame.data(), true);
+
+            // Log compression evens out loud and quiet partials
+            for (int b = 0; b < numBins; ++b)
+                frame[static_cast<size_t>(b)] = std::log1p(10.0f * frame[static_cast<size_t>(b)]);
+
+            juce::FloatVectorOperations::subtract(rise.data(), frame.data(), previous.data(), numBins);
+            juce::FloatVectorOperations::max(rise.data(), rise.data(), 0.0f, numBins);
+            juce::FloatVectorOperations::copy(previous.data(), frame.data(), numBins);
+
+            float sum = 0.0f;
+            for (float r : rise)
+                sum += r;
+
+            flux.push_back(sum);
+        }
+
+        return flux;
+    }
+
+    // The new energy of frame i arrives in its last hop; place the onset at
+    // the block with the largest energy jump there, a little early so the
+    // attack isn't clipped
+    static int refine(const float* mono, int numSamples, int frameIndex)
+    {
+        int searchStart = std::max(0, frameIndex * HOP_SIZE + FFT_SIZE - 2 * HOP_SIZE);
+        int searchEnd = std::min(numSamples, frameIndex * HOP_SIZE + FFT_SIZE);
+
+        int best = searchStart;
+        float bestJump = 0.0f;
+
+        for (int pos = searchStart; pos < searchEnd; pos += ENERGY_BLOCK / 2)
+        {
+            float jump = blockEnergy(mono, numSamples, pos) - blockEnergy(mono, numSamples, pos - ENERGY_BLOCK);
+
+            if (jump > bestJump)
+            {
+                bestJump = jump;
+                best = pos;
+            }
+        }
+
+        return std::max(0, best - ENERGY_BLOCK / 2);
+    }
+
+    static float blockEnergy(const float* mono, int numSamples, int start)
+    {
+        float energy = 0.0f;
+        for (int i = std::max(0, start); i < std::min(numSamples, start + ENERGY_BLOCK); ++i)
+            energy += mono[i] * mono[i];
+        return energy;
+    }
+};
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+#include <cmath>
+#include <algorithm>
+#include "BlockSmoothing.h"
+
+// A parameter that glides to each new target over a fixed time. fill()
+// writes one value per sample for the coming block, so the caller can apply
+// it with vector operations instead of smoothing inside its sample loop;
+// while not ramping, getCurrent() is the value for every sample.
+//
+// Multiplicative ramps (constant ratio per sample) suit gains, where a
+// linear ramp would spend most of its time near the louder end. They fall
+// back to linear when either end isn't positive.
+class ParameterRamp
+{
+public:
+    enum class Shape
+    {
+        Linear,
+        Multiplicative
+    };
+
+    explicit ParameterRamp(Shape rampShape = Shape::Linear, float initialValue = 0.0f)
+        : shape(rampShape), current(initialValue), target(initialValue)
+    {
+    }
+
+    void prepare(double sampleRate, int maxBlockSize, double rampSeconds = BlockSmoothing::SMOOTHING_SECONDS)
+    {
+        rampSamples = std::max(1, static_cast<int>(std::lround(sampleRate * rampSeconds)));
+        values.assign(static_cast<size_t>(std::max(maxBlockSize, 1)), target);
+        snap();
+    }
+
+    void setTarget(float newTarget)
+    {
+        if (newTarget == target)
+            return;
+
+        target = newTarget;
+        remaining = rampSamples;
+        multiplying = shape == Shape::Multiplicative && current > 0.0f && target > 0.0f;
+        step = multiplying ? std::pow(target / current, 1.0f / static_cast<float>(rampSamples))
+                           : (target - current) / static_cast<float>(rampSamples);
+    }
+
+    // Jumps to the target (after prepare, or when nothing is playing)
+    void snap()
+    {
+        current = target;
+        remaining = 0;
+    }
+
+    bool isRamping() const { return remaining > 0; }
+    float getCurrent() const { return current; }
+    float getTarget() const { return target; }
+
+    // Values for the next numSamples samples (at most the prepared block size)
+    const float* fill(int numSamples)
+    {
+        numSamples = std::min(numSamples, static_cast<int>(values.size()));
+        float* v = values.data();
+        int count = std::min(remaining, numSamples);
+
+        if (multiplying)
+        {
+            float x = current;
+            for (int i = 0; i < count; ++i)
+            {
+                x *= step;
+                v[i] = x;
+            }
+        }
+        else
+        {
+            for (int i = 0; i < count; ++i)
+                v[i] = current + step * static_cast<float>(i + 1);
+        }
+
+        remaining -= count;
+
+        if (count > 0)
+        {
+            // Land exactly on the target rather than wherever rounding left it
+            if (remaining == 0)
+                v[count - 1] = target;
+
+            current = v[count - 1];
+        }
+
+        std::fill(v + count, v + numSamples, current);
+        return v;
+    }
+
+private:
+    Shape shape;
+    float current;
+    float target;
+    float step = 0.0f;
+    int remaining = 0;
+    int rampSamples = 1;
+    bool multiplying = false;
+    std::vector<float> values;
+};
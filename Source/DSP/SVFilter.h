@@ -1,15 +1,30 @@
 #pragma once
 
 #include <cmath>
+#include <array>
+#include <algorithm>
+#include "FastMath.h"
+#include "HalfBandOversampler.h"
 
+// Stereo per-slot filter: TPT state-variable modes plus a ZDF 4-pole ladder.
+// Coefficients are computed when parameters are set (control rate), not per sample.
+//
+// Every type, and bypass, comes out LATENCY samples late: the SVF modes run
+// on a delayed input that matches the ladder's half-band round trip, so
+// layered slots line up and a type change never jumps in time.
 class SVFilter
 {
 public:
+    using Frame = HalfBandOversampler::Frame;
+
+    static constexpr int LATENCY = HalfBandOversampler::LATENCY;
+
     enum class Type
     {
         LowPass,
         HighPass,
-        BandPass
+        BandPass,
+        Ladder
     };
 
     SVFilter() = default;
@@ -17,80 +32,284 @@ public:
     void prepare(double sampleRate)
     {
         this->sampleRate = sampleRate;
+        updateCoefficients();
         reset();
     }
 
     void reset()
     {
-        ic1eq = 0.0f;
-        ic2eq = 0.0f;
+        ic1eq = {};
+        ic2eq = {};
+        ladderState = {};
+        oversampler.reset();
+        alignment = {};
+        alignmentPosition = 0;
+        fadeRemaining = 0;
+        started = false;
     }
 
-    void setType(Type newType) { type = newType; }
-    void setCutoff(float frequencyHz) { cutoffHz = frequencyHz; }
-    void setResonance(float res) { resonance = std::clamp(res, 0.0f, 1.0f); }
+    void setType(Type newType) { changeType(newType); updateCoefficients(); }
+    void setCutoff(float frequencyHz) { cutoffHz = frequencyHz; updateCoefficients(); }
+    void setResonance(float res) { resonance = std::clamp(res, 0.0f, 1.0f); updateCoefficients(); }
+
+    // Sets everything at once with a single coefficient update (once per control tick)
+    void setParameters(Type newType, float frequencyHz, float res)
+    {
+        changeType(newType);
+        cutoffHz = frequencyHz;
+        resonance = std::clamp(res, 0.0f, 1.0f);
+        updateCoefficients();
+    }
 
-    float process(float input)
+    // Processes one stereo frame in place
+    void process(float& left, float& right)
     {
         // Sanitize input
-        if (!std::isfinite(input))
-            return 0.0f;
+        Frame input { std::isfinite(left) ? left : 0.0f,
+                      std::isfinite(right) ? right : 0.0f };
+        Frame delayed = align(input);
+        Frame output;
+
+        processType(type, input, delayed, output);
+
+        if (fadeRemaining > 0)
+        {
+            // Crossfade out of the previous type while the new one settles
+            Frame previous;
+            processType(previousType, input, delayed, previous);
+
+            float fade = static_cast<float>(fadeRemaining) / static_cast<float>(TYPE_FADE_SAMPLES);
+            for (size_t c = 0; c < 2; ++c)
+                output[c] += fade * (previous[c] - output[c]);
+
+            --fadeRemaining;
+        }
+        else if (type != Type::Ladder)
+        {
+            primeLadder(input);
+        }
+
+        started = true;
+        left = std::isfinite(output[0]) ? output[0] : delayed[0];
+        right = std::isfinite(output[1]) ? output[1] : delayed[1];
+    }
+
+    // Bypassed frame: the input comes out as late as any filter type would
+    // make it, and the ladder's upsampler keeps listening
+    void processBypassed(float& left, float& right)
+    {
+        Frame input { std::isfinite(left) ? left : 0.0f,
+                      std::isfinite(right) ? right : 0.0f };
+        Frame delayed = align(input);
+        primeLadder(input);
+
+        left = delayed[0];
+        right = delayed[1];
+    }
+
+private:
+    // Long enough for the half-band histories to fill before the new path
+    // carries the full signal
+    static constexpr int TYPE_FADE_SAMPLES = 64;
+
+    // Moving between the SVF modes and the ladder swaps to a different state
+    // and delay path, so that change crossfades. The SVF modes share state
+    // and switch directly, as does the first setting after a reset.
+    void changeType(Type newType)
+    {
+        if (started && (newType == Type::Ladder) != (type == Type::Ladder))
+        {
+            previousType = type;
+            fadeRemaining = TYPE_FADE_SAMPLES;
+        }
+
+        type = newType;
+    }
+
+    void processType(Type mode, const Frame& input, const Frame& delayed, Frame& output)
+    {
+        if (mode == Type::Ladder)
+            processLadder(input, output);
+        else
+            processSVF(delayed, output, mode);
+    }
+
+    // The input LATENCY frames ago
+    Frame align(const Frame& input)
+    {
+        auto& slot = alignment[static_cast<size_t>(alignmentPosition)];
+        Frame delayed = slot;
+        slot = input;
+        alignmentPosition = (alignmentPosition + 1) % LATENCY;
+        return delayed;
+    }
+
+    void primeLadder(const Frame& input)
+    {
+        oversampler.prime({ input[0] * ladderInputGain, input[1] * ladderInputGain });
+    }
+
+    // Both coefficient sets stay current so a crossfade can run either path
+    void updateCoefficients()
+    {
+        updateLadderCoefficients();
+        updateSVFCoefficients();
+    }
+
+    void updateLadderCoefficients()
+    {
+        // Ladder runs at twice the host rate to keep resonance clean
+        double oversampledRate = sampleRate * 2.0;
+        float freq = std::clamp(cutoffHz, 20.0f, static_cast<float>(sampleRate * 0.49));
+        float g = std::tan(3.14159265359f * freq / static_cast<float>(oversampledRate));
 
+        // One-pole TPT stage: y = G * x + B * s
+        ladderG = g / (1.0f + g);
+        float b = 1.0f / (1.0f + g);
+
+        // Feedback gain, self-oscillation at k = 4
+        ladderK = resonance * 4.0f;
+
+        // Contribution of each stage's state to the ladder output
+        ladderS0 = b * ladderG * ladderG * ladderG;
+        ladderS1 = b * ladderG * ladderG;
+        ladderS2 = b * ladderG;
+        ladderS3 = b;
+
+        float g4 = ladderG * ladderG * ladderG * ladderG;
+        ladderFeedbackNorm = 1.0f / (1.0f + ladderK * g4);
+
+        // Partially restores the passband level lost to feedback
+        ladderInputGain = 1.0f + 0.5f * ladderK;
+    }
+
+    void updateSVFCoefficients()
+    {
         // Clamp cutoff to valid range
         float freq = std::clamp(cutoffHz, 20.0f, static_cast<float>(sampleRate * 0.49));
 
         // Calculate coefficients (TPT/Trapezoidal SVF)
         float g = std::tan(3.14159265359f * freq / static_cast<float>(sampleRate));
-        float k = 2.0f - 2.0f * resonance; // Q = 1/(2-2*res), so k = 2*(1-res) for stability
+        k = 2.0f - 2.0f * resonance; // Q = 1/(2-2*res), so k = 2*(1-res) for stability
 
         // Ensure k doesn't go too low (prevents self-oscillation issues)
         k = std::max(k, 0.1f);
 
-        float a1 = 1.0f / (1.0f + g * (g + k));
-        float a2 = g * a1;
-        float a3 = g * a2;
+        a1 = 1.0f / (1.0f + g * (g + k));
+        a2 = g * a1;
+        a3 = g * a2;
+    }
 
-        // Process
-        float v3 = input - ic2eq;
-        float v1 = a1 * ic1eq + a2 * v3;
-        float v2 = ic2eq + a2 * ic1eq + a3 * v3;
+    void processSVF(const Frame& input, Frame& output, Type mode)
+    {
+        for (size_t c = 0; c < 2; ++c)
+        {
+            float v3 = input[c] - ic2eq[c];
+            float v1 = a1 * ic1eq[c] + a2 * v3;
+            float v2 = ic2eq[c] + a2 * ic1eq[c] + a3 * v3;
 
-        // Update state
-        ic1eq = 2.0f * v1 - ic1eq;
-        ic2eq = 2.0f * v2 - ic2eq;
+            // Update state
+            ic1eq[c] = 2.0f * v1 - ic1eq[c];
+            ic2eq[c] = 2.0f * v2 - ic2eq[c];
 
-        // Protect filter state from corruption
-        if (!std::isfinite(ic1eq)) ic1eq = 0.0f;
-        if (!std::isfinite(ic2eq)) ic2eq = 0.0f;
+            // Protect filter state from corruption
+            if (!std::isfinite(ic1eq[c])) ic1eq[c] = 0.0f;
+            if (!std::isfinite(ic2eq[c])) ic2eq[c] = 0.0f;
 
-        // Output based on filter type
-        float output;
-        switch (type)
-        {
-            case Type::LowPass:
-                output = v2;
-                break;
-            case Type::HighPass:
-                output = input - k * v1 - v2;
-                break;
-            case Type::BandPass:
-                output = v1;
-                break;
-            default:
-                output = v2;
-                break;
+            // Output based on filter type
+            switch (mode)
+            {
+                case Type::HighPass: output[c] = input[c] - k * v1 - v2; break;
+                case Type::BandPass: output[c] = v1; break;
+                default:             output[c] = v2; break;
+            }
         }
+    }
+
+    // === ZDF LADDER ===
+    // Four TPT one-poles with global feedback. The linear feedback loop is
+    // solved exactly, then the stage input goes through a polynomial tanh.
+    // Runs at twice the rate between the half-band up- and downsampler.
+    void processLadder(const Frame& input, Frame& output)
+    {
+        HalfBandOversampler::Frame gained { input[0] * ladderInputGain, input[1] * ladderInputGain };
+        HalfBandOversampler::Frame first, second;
+        oversampler.upsample(gained, first, second);
 
-        return std::isfinite(output) ? output : input;
+        ladderSubStep(first);
+        ladderSubStep(second);
+
+        // Keep a blow-up out of the downsampler's history
+        for (auto* frame : { &first, &second })
+            for (auto& value : *frame)
+                if (!std::isfinite(value)) value = 0.0f;
+
+        oversampler.downsample(first, second, output);
+
+        for (auto& stage : ladderState)
+            for (auto& lane : stage)
+                if (!std::isfinite(lane)) lane = 0.0f;
+    }
+
+    // One oversampled step for both channels, in place
+    void ladderSubStep(std::array<float, 2>& x)
+    {
+        auto& s = ladderState;
+
+        for (size_t c = 0; c < 2; ++c)
+        {
+            float feedbackState = ladderS0 * s[0][c] + ladderS1 * s[1][c]
+                                + ladderS2 * s[2][c] + ladderS3 * s[3][c];
+
+            float u = FastMath::tanhApprox((x[c] - ladderK * feedbackState) * ladderFeedbackNorm);
+
+            for (auto& stage : s)
+            {
+                float v = (u - stage[c]) * ladderG;
+                float y = v + stage[c];
+                stage[c] = y + v;
+                u = y;
+            }
+
+            x[c] = u;
+        }
     }
 
-private:
     double sampleRate = 44100.0;
     Type type = Type::LowPass;
     float cutoffHz = 10000.0f;
     float resonance = 0.1f;
 
-    // State variables
-    float ic1eq = 0.0f;
-    float ic2eq = 0.0f;
+    // SVF coefficients
+    float k = 1.8f;
+    float a1 = 0.0f;
+    float a2 = 0.0f;
+    float a3 = 0.0f;
+
+    // SVF state variables (L/R)
+    std::array<float, 2> ic1eq {};
+    std::array<float, 2> ic2eq {};
+
+    // Ladder coefficients
+    float ladderG = 0.0f;
+    float ladderK = 0.0f;
+    float ladderS0 = 0.0f;
+    float ladderS1 = 0.0f;
+    float ladderS2 = 0.0f;
+    float ladderS3 = 0.0f;
+    float ladderFeedbackNorm = 1.0f;
+    float ladderInputGain = 1.0f;
+
+    // Ladder state: four stages, L/R lanes side by side
+    std::array<std::array<float, 2>, 4> ladderState {};
+    HalfBandOversampler oversampler;
+
+    // Delay line that lines the SVF modes and bypass up with the ladder
+    std::array<Frame, LATENCY> alignment {};
+    int alignmentPosition = 0;
+
+    // Type crossfade
+    Type previousType = Type::LowPass;
+    int fadeRemaining = 0;
+    bool started = false;
 };
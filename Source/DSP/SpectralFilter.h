@@ -2,15 +2,25 @@
 
 #include <cmath>
 #include <algorithm>
+#include "BlockSmoothing.h"
+#include "ParameterRamp.h"
 
 class SpectralFilter
 {
 public:
     SpectralFilter() = default;
 
-    void prepare(double newSampleRate, int /*maxBlockSize*/)
+    void prepare(double newSampleRate, int maxBlockSize)
     {
         sampleRate = newSampleRate;
+        mixRamp.prepare(sampleRate, maxBlockSize);
+
+        // Band split points are fixed, so only the rate changes them
+        lowSplitG = BlockSmoothing::onePoleCoefficient(300.0f, sampleRate);
+        highSplitG = BlockSmoothing::onePoleCoefficient(4000.0f, sampleRate);
+
+        coefficients.prepare(sampleRate);
+
         resetFilters();
     }
 
@@ -19,18 +29,16 @@ public:
         resetFilters();
     }
 
-    void setLowGain(float g) { lowGain = std::clamp(g, -12.0f, 12.0f); }
-    void setMidGain(float g) { midGain = std::clamp(g, -12.0f, 12.0f); }
-    void setHighGain(float g) { highGain = std::clamp(g, -12.0f, 12.0f); }
-    void setSpread(float s) { spread = std::clamp(s, 0.0f, 1.0f); }
-    void setMix(float m) { mix = std::clamp(m, 0.0f, 1.0f); }
+    void setLowGain(float g) { coefficients.set(&Params::lowGain, std::clamp(g, -12.0f, 12.0f)); }
+    void setMidGain(float g) { coefficients.set(&Params::midGain, std::clamp(g, -12.0f, 12.0f)); }
+    void setHighGain(float g) { coefficients.set(&Params::highGain, std::clamp(g, -12.0f, 12.0f)); }
+    void setSpread(float s) { coefficients.set(&Params::spread, std::clamp(s, 0.0f, 1.0f)); }
+    void setMix(float m) { mixRamp.setTarget(std::clamp(m, 0.0f, 1.0f)); }
 
     void processBlock(float* left, float* right, int numSamples)
     {
-        // Convert dB gains to linear
-        float lowLinear = std::pow(10.0f, lowGain / 20.0f);
-        float midLinear = std::pow(10.0f, midGain / 20.0f);
-        float highLinear = std::pow(10.0f, highGain / 20.0f);
+        const auto& c = coefficients.update(numSamples);
+        const float* mix = mixRamp.fill(numSamples);
 
         for (int i = 0; i < numSamples; ++i)
         {
@@ -44,45 +52,45 @@ public:
             // === SPLIT INTO 3 BANDS ===
 
             // Low band: below 300Hz
-            float lowL = lowPassL1(left[i], 300.0f);
-            float lowR = lowPassR1(right[i], 300.0f);
+            float lowL = lowPassL1(left[i]);
+            float lowR = lowPassR1(right[i]);
 
             // High band: above 4kHz
-            float highL = highPassL(left[i], 4000.0f);
-            float highR = highPassR(right[i], 4000.0f);
+            float highL = highPassL(left[i]);
+            float highR = highPassR(right[i]);
 
             // Mid band: 300Hz - 4kHz (what's left)
             float midL = left[i] - lowL - highL;
             float midR = right[i] - lowR - highR;
 
             // === APPLY GAINS ===
-            lowL *= lowLinear;
-            lowR *= lowLinear;
-            midL *= midLinear;
-            midR *= midLinear;
-            highL *= highLinear;
-            highR *= highLinear;
+            lowL *= c.lowLinear;
+            lowR *= c.lowLinear;
+            midL *= c.midLinear;
+            midR *= c.midLinear;
+            highL *= c.highLinear;
+            highR *= c.highLinear;
 
             // === SPECTRAL SPREAD (stereo widening per band) ===
-            if (spread > 0.0f)
+            if (c.spread > 0.0f)
             {
                 // Apply different stereo widths to each band
                 // Low: mono, Mid: normal, High: wide
                 float lowMono = (lowL + lowR) * 0.5f;
-                lowL = lowMono + (lowL - lowMono) * (1.0f - spread * 0.5f);
-                lowR = lowMono + (lowR - lowMono) * (1.0f - spread * 0.5f);
+                lowL = lowMono + (lowL - lowMono) * c.lowWidth;
+                lowR = lowMono + (lowR - lowMono) * c.lowWidth;
 
                 // Mid stays as-is (or slight widening)
                 float midMid = (midL + midR) * 0.5f;
                 float midSide = (midL - midR) * 0.5f;
-                midSide *= (1.0f + spread * 0.3f);
+                midSide *= c.midWidth;
                 midL = midMid + midSide;
                 midR = midMid - midSide;
 
                 // High: enhanced stereo
                 float highMid = (highL + highR) * 0.5f;
                 float highSide = (highL - highR) * 0.5f;
-                highSide *= (1.0f + spread);
+                highSide *= c.highWidth;
                 highL = highMid + highSide;
                 highR = highMid - highSide;
             }
@@ -96,8 +104,8 @@ public:
             wetR = softLimit(wetR);
 
             // === MIX ===
-            float outL = dryL * (1.0f - mix) + wetL * mix;
-            float outR = dryR * (1.0f - mix) + wetR * mix;
+            float outL = dryL + (wetL - dryL) * mix[i];
+            float outR = dryR + (wetR - dryR) * mix[i];
 
             // Final sanitization
             left[i] = std::isfinite(outL) ? outL : dryL;
@@ -106,13 +114,58 @@ public:
     }
 
 private:
+    struct Params
+    {
+        float lowGain = 0.0f;  // dB
+        float midGain = 0.0f;  // dB
+        float highGain = 0.0f; // dB
+        float spread = 0.0f;   // Spectral stereo spread
+    };
+
+    // Everything the sample loop needs from the parameters
+    struct Coefficients
+    {
+        float lowLinear = 1.0f;
+        float midLinear = 1.0f;
+        float highLinear = 1.0f;
+        float spread = 0.0f;
+        float lowWidth = 1.0f;
+        float midWidth = 1.0f;
+        float highWidth = 1.0f;
+
+        bool approach(const Coefficients& target, float amount)
+        {
+            bool moving = BlockSmoothing::approach(lowLinear, target.lowLinear, amount);
+            moving |= BlockSmoothing::approach(midLinear, target.midLinear, amount);
+            moving |= BlockSmoothing::approach(highLinear, target.highLinear, amount);
+            moving |= BlockSmoothing::approach(spread, target.spread, amount);
+            moving |= BlockSmoothing::approach(lowWidth, target.lowWidth, amount);
+            moving |= BlockSmoothing::approach(midWidth, target.midWidth, amount);
+            moving |= BlockSmoothing::approach(highWidth, target.highWidth, amount);
+            return moving;
+        }
+    };
+
+    static Coefficients computeCoefficients(const Params& p, double /*sampleRate*/)
+    {
+        // dB gains to linear
+        Coefficients c;
+        c.lowLinear = std::pow(10.0f, p.lowGain / 20.0f);
+        c.midLinear = std::pow(10.0f, p.midGain / 20.0f);
+        c.highLinear = std::pow(10.0f, p.highGain / 20.0f);
+        c.spread = p.spread;
+        c.lowWidth = 1.0f - p.spread * 0.5f;
+        c.midWidth = 1.0f + p.spread * 0.3f;
+        c.highWidth = 1.0f + p.spread;
+        return c;
+    }
+
     // === BAND-SPLIT FILTERS ===
 
     // Low-pass for low band extraction (2-pole)
-    float lowPassL1(float input, float cutoffHz)
+    float lowPassL1(float input)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
+        const float g = lowSplitG;
 
         lpfStateL1 = lpfStateL1 + g * (input - lpfStateL1);
         lpfStateL2 = lpfStateL2 + g * (lpfStateL1 - lpfStateL2);
@@ -123,10 +176,9 @@ private:
         return lpfStateL2;
     }
 
-    float lowPassR1(float input, float cutoffHz)
+    float lowPassR1(float input)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
+        const float g = lowSplitG;
 
         lpfStateR1 = lpfStateR1 + g * (input - lpfStateR1);
         lpfStateR2 = lpfStateR2 + g * (lpfStateR1 - lpfStateR2);
@@ -138,10 +190,9 @@ private:
     }
 
     // High-pass for high band extraction (2-pole)
-    float highPassL(float input, float cutoffHz)
+    float highPassL(float input)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
+        const float g = highSplitG;
 
         hpfStateL1 = hpfStateL1 + g * (input - hpfStateL1);
         hpfStateL2 = hpfStateL2 + g * (hpfStateL1 - hpfStateL2);
@@ -153,10 +204,9 @@ private:
         return input - hpfStateL2;
     }
 
-    float highPassR(float input, float cutoffHz)
+    float highPassR(float input)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
+        const float g = highSplitG;
 
         hpfStateR1 = hpfStateR1 + g * (input - hpfStateR1);
         hpfStateR2 = hpfStateR2 + g * (hpfStateR1 - hpfStateR2);
@@ -190,15 +240,15 @@ private:
     }
 
     // Parameters
-    float lowGain = 0.0f;   // dB
-    float midGain = 0.0f;   // dB
-    float highGain = 0.0f;  // dB
-    float spread = 0.0f;    // Spectral stereo spread
-    float mix = 1.0f;       // Wet/dry mix
+    ParameterRamp mixRamp { ParameterRamp::Shape::Linear, 1.0f }; // Wet/dry mix, ramped per sample
 
     // State
     double sampleRate = 44100.0;
 
+    SmoothedCoefficients<Params, Coefficients> coefficients { &SpectralFilter::computeCoefficients };
+    float lowSplitG = 0.0f;
+    float highSplitG = 0.0f;
+
     // Low-pass filter states (for low band)
     float lpfStateL1 = 0.0f;
     float lpfStateL2 = 0.0f;
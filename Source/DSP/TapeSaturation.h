@@ -2,15 +2,25 @@
 
 #include <cmath>
 #include <algorithm>
+#include "BlockSmoothing.h"
+#include "ParameterRamp.h"
 
 class TapeSaturation
 {
 public:
     TapeSaturation() = default;
 
-    void prepare(double newSampleRate, int /*maxBlockSize*/)
+    void prepare(double newSampleRate, int maxBlockSize)
     {
         sampleRate = newSampleRate;
+        mixRamp.prepare(sampleRate, maxBlockSize);
+
+        // Fixed corner frequencies only depend on the rate
+        dcBlockG = BlockSmoothing::onePoleCoefficient(30.0f, sampleRate);
+        bassG = BlockSmoothing::onePoleCoefficient(100.0f, sampleRate);
+
+        coefficients.prepare(sampleRate);
+
         resetFilters();
     }
 
@@ -19,13 +29,16 @@ public:
         resetFilters();
     }
 
-    void setDrive(float d) { drive = std::clamp(d, 0.0f, 1.0f); }
-    void setTone(float t) { tone = std::clamp(t, 0.0f, 1.0f); }
-    void setMix(float m) { mix = std::clamp(m, 0.0f, 1.0f); }
-    void setCompression(float c) { compression = std::clamp(c, 0.0f, 1.0f); }
+    void setDrive(float d) { coefficients.set(&Params::drive, std::clamp(d, 0.0f, 1.0f)); }
+    void setTone(float t) { coefficients.set(&Params::tone, std::clamp(t, 0.0f, 1.0f)); }
+    void setMix(float m) { mixRamp.setTarget(std::clamp(m, 0.0f, 1.0f)); }
+    void setCompression(float c) { coefficients.set(&Params::compression, std::clamp(c, 0.0f, 1.0f)); }
 
     void processBlock(float* left, float* right, int numSamples)
     {
+        const auto& c = coefficients.update(numSamples);
+        const float* mix = mixRamp.fill(numSamples);
+
         for (int i = 0; i < numSamples; ++i)
         {
             // Sanitize input
@@ -36,17 +49,15 @@ public:
             float dryR = right[i];
 
             // === INPUT GAIN (drive) ===
-            // Drive of 0 = 1x gain, drive of 1 = 10x gain
-            float inputGain = 1.0f + drive * 9.0f;
-            float wetL = dryL * inputGain;
-            float wetR = dryR * inputGain;
+            float wetL = dryL * c.inputGain;
+            float wetR = dryR * c.inputGain;
 
             // === TAPE COMPRESSION ===
             // Soft knee compression before saturation
-            if (compression > 0.0f)
+            if (c.inverseRatio < 1.0f)
             {
-                wetL = tapeCompress(wetL);
-                wetR = tapeCompress(wetR);
+                wetL = tapeCompress(wetL, c.inverseRatio);
+                wetR = tapeCompress(wetR, c.inverseRatio);
             }
 
             // === TAPE SATURATION (asymmetric for warmth) ===
@@ -55,24 +66,20 @@ public:
 
             // === TAPE HEAD HIGH FREQUENCY ROLL-OFF ===
             // Simulates the frequency response of tape heads
-            // Tone: 0 = dark (2kHz), 1 = bright (18kHz)
-            float cutoff = 2000.0f + tone * 16000.0f;
-            wetL = tapeHeadFilterL(wetL, cutoff);
-            wetR = tapeHeadFilterR(wetR, cutoff);
+            wetL = tapeHeadFilterL(wetL, c.headG);
+            wetR = tapeHeadFilterR(wetR, c.headG);
 
             // === SLIGHT BASS BUMP (tape characteristic) ===
-            wetL = bassBumpL(wetL);
-            wetR = bassBumpR(wetR);
+            wetL = bassBumpL(wetL, c.bassAmount);
+            wetR = bassBumpR(wetR, c.bassAmount);
 
             // === OUTPUT LEVEL COMPENSATION ===
-            // Reduce output to compensate for drive gain
-            float outputComp = 1.0f / (1.0f + drive * 2.0f);
-            wetL *= outputComp;
-            wetR *= outputComp;
+            wetL *= c.outputComp;
+            wetR *= c.outputComp;
 
             // === MIX ===
-            float outL = dryL * (1.0f - mix) + wetL * mix;
-            float outR = dryR * (1.0f - mix) + wetR * mix;
+            float outL = dryL + (wetL - dryL) * mix[i];
+            float outR = dryR + (wetR - dryR) * mix[i];
 
             // Final sanitization
             left[i] = std::isfinite(outL) ? outL : dryL;
@@ -81,12 +88,49 @@ public:
     }
 
 private:
+    struct Params
+    {
+        float drive = 0.3f;       // Input drive
+        float tone = 0.7f;        // High frequency rolloff
+        float compression = 0.3f; // Tape compression amount
+    };
+
+    // Everything the sample loop needs from the parameters
+    struct Coefficients
+    {
+        float inputGain = 1.0f;     // drive 0 = 1x, drive 1 = 10x
+        float inverseRatio = 1.0f;  // compression 1:1 to 4:1
+        float headG = 0.0f;         // tape head low-pass, 2kHz (dark) to 18kHz (bright)
+        float bassAmount = 0.0f;
+        float outputComp = 1.0f;    // makes up for the drive gain
+
+        bool approach(const Coefficients& target, float amount)
+        {
+            bool moving = BlockSmoothing::approach(inputGain, target.inputGain, amount);
+            moving |= BlockSmoothing::approach(inverseRatio, target.inverseRatio, amount);
+            moving |= BlockSmoothing::approach(headG, target.headG, amount);
+            moving |= BlockSmoothing::approach(bassAmount, target.bassAmount, amount);
+            moving |= BlockSmoothing::approach(outputComp, target.outputComp, amount);
+            return moving;
+        }
+    };
+
+    static Coefficients computeCoefficients(const Params& p, double sampleRate)
+    {
+        Coefficients c;
+        c.inputGain = 1.0f + p.drive * 9.0f;
+        c.inverseRatio = 1.0f / (1.0f + p.compression * 3.0f);
+        c.headG = BlockSmoothing::onePoleCoefficient(2000.0f + p.tone * 16000.0f, sampleRate);
+        c.bassAmount = 0.15f * p.drive;
+        c.outputComp = 1.0f / (1.0f + p.drive * 2.0f);
+        return c;
+    }
+
     // === TAPE COMPRESSION ===
     // Soft knee compression characteristic of tape
-    float tapeCompress(float x)
+    float tapeCompress(float x, float inverseRatio)
     {
         float threshold = 0.5f;
-        float ratio = 1.0f + compression * 3.0f; // 1:1 to 4:1
 
         float absX = std::abs(x);
         float sign = (x >= 0.0f) ? 1.0f : -1.0f;
@@ -96,7 +140,7 @@ private:
 
         // Soft knee compression above threshold
         float excess = absX - threshold;
-        float compressed = threshold + excess / ratio;
+        float compressed = threshold + excess * inverseRatio;
 
         return sign * compressed;
     }
@@ -124,11 +168,8 @@ private:
 
     // === TAPE HEAD FILTER (per channel) ===
     // 2-pole Butterworth low-pass
-    float tapeHeadFilterL(float input, float cutoffHz)
+    float tapeHeadFilterL(float input, float g)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
-
         // Two cascaded one-pole filters for 2-pole response
         tapeHpState1L = tapeHpState1L + g * (input - tapeHpState1L);
         tapeHpState2L = tapeHpState2L + g * (tapeHpState1L - tapeHpState2L);
@@ -139,11 +180,8 @@ private:
         return tapeHpState2L;
     }
 
-    float tapeHeadFilterR(float input, float cutoffHz)
+    float tapeHeadFilterR(float input, float g)
     {
-        float omega = 2.0f * 3.14159265359f * cutoffHz / static_cast<float>(sampleRate);
-        float g = omega / (1.0f + omega);
-
         tapeHpState1R = tapeHpState1R + g * (input - tapeHpState1R);
         tapeHpState2R = tapeHpState2R + g * (tapeHpState1R - tapeHpState2R);
 
@@ -155,35 +193,27 @@ private:
 
     // === BASS BUMP (subtle low frequency emphasis) ===
     // Simulates tape machine's low-end warmth
-    float bassBumpL(float input)
+    float bassBumpL(float input, float amount)
     {
         // Very subtle high-pass at 30Hz to remove DC
-        float hpOmega = 2.0f * 3.14159265359f * 30.0f / static_cast<float>(sampleRate);
-        float hpG = hpOmega / (1.0f + hpOmega);
-        dcBlockStateL = dcBlockStateL + hpG * (input - dcBlockStateL);
+        dcBlockStateL = dcBlockStateL + dcBlockG * (input - dcBlockStateL);
         float hp = input - dcBlockStateL;
 
         // Low shelf boost around 100Hz
-        float lsOmega = 2.0f * 3.14159265359f * 100.0f / static_cast<float>(sampleRate);
-        float lsG = lsOmega / (1.0f + lsOmega);
-        bassStateL = bassStateL + lsG * (hp - bassStateL);
+        bassStateL = bassStateL + bassG * (hp - bassStateL);
 
-        // Add subtle bass boost (15%)
-        return hp + bassStateL * 0.15f * drive;
+        // Add subtle bass boost (up to 15%)
+        return hp + bassStateL * amount;
     }
 
-    float bassBumpR(float input)
+    float bassBumpR(float input, float amount)
     {
-        float hpOmega = 2.0f * 3.14159265359f * 30.0f / static_cast<float>(sampleRate);
-        float hpG = hpOmega / (1.0f + hpOmega);
-        dcBlockStateR = dcBlockStateR + hpG * (input - dcBlockStateR);
+        dcBlockStateR = dcBlockStateR + dcBlockG * (input - dcBlockStateR);
         float hp = input - dcBlockStateR;
 
-        float lsOmega = 2.0f * 3.14159265359f * 100.0f / static_cast<float>(sampleRate);
-        float lsG = lsOmega / (1.0f + lsOmega);
-        bassStateR = bassStateR + lsG * (hp - bassStateR);
+        bassStateR = bassStateR + bassG * (hp - bassStateR);
 
-        return hp + bassStateR * 0.15f * drive;
+        return hp + bassStateR * amount;
     }
 
     void resetFilters()
@@ -199,14 +229,15 @@ private:
     }
 
     // Parameters
-    float drive = 0.3f;         // Input drive
-    float tone = 0.7f;          // High frequency rolloff
-    float mix = 0.5f;           // Wet/dry mix
-    float compression = 0.3f;   // Tape compression amount
+    ParameterRamp mixRamp { ParameterRamp::Shape::Linear, 0.5f }; // Wet/dry mix, ramped per sample
 
     // State
     double sampleRate = 44100.0;
 
+    SmoothedCoefficients<Params, Coefficients> coefficients { &TapeSaturation::computeCoefficients };
+    float dcBlockG = 0.0f;
+    float bassG = 0.0f;
+
     // Filter states
     float tapeHpState1L = 0.0f;
     float tapeHpState2L = 0.0f;
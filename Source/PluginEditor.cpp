@@ -8,6 +8,7 @@ OmniverseAudioProcessorEditor::OmniverseAudioProcessorEditor(OmniverseAudioProce
 
     setupHeader();
     setupMasterControls();
+    setupMorphControls();
     setupPlaybackModes();
     setupSlotPanels();
     setupTabs();
@@ -20,7 +21,8 @@ OmniverseAudioProcessorEditor::OmniverseAudioProcessorEditor(OmniverseAudioProce
     effectsPanel = std::make_unique<EffectsPanel>(processorRef);
     addAndMakeVisible(*effectsPanel);
 
-    // Start on Effects tab
+    // Start on the first slot page and the Effects tab
+    showSlotPage(0);
     switchToTab(Tab::Effects);
 
     setSize(1024, 700);
@@ -44,6 +46,93 @@ void OmniverseAudioProcessorEditor::setupHeader()
     versionLabel.setFont(OmniverseLookAndFeel::getBodyFont(14.0f));
     versionLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
     addAndMakeVisible(versionLabel);
+
+    bankButton.setButtonText("banks");
+    bankButton.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+    bankButton.setColour(juce::TextButton::textColourOffId, juce::Colours::grey);
+    bankButton.onClick = [this]() { showBankMenu(); };
+    addAndMakeVisible(bankButton);
+}
+
+void OmniverseAudioProcessorEditor::showBankMenu()
+{
+    const auto& banks = processorRef.getBankDefinitions();
+
+    auto bankLabel = [&banks](int program)
+    {
+        auto it = banks.find(program);
+        return juce::String(program + 1) + (it != banks.end() ? ": " + it->second.name : juce::String());
+    };
+
+    juce::PopupMenu storeMenu;
+    for (int program = 0; program < 128; ++program)
+        storeMenu.addItem(STORE_BANK_ITEM + program, bankLabel(program));
+
+    juce::PopupMenu menu;
+    menu.addSubMenu("Store slots as program", storeMenu);
+
+    if (!banks.empty())
+    {
+        juce::PopupMenu removeMenu;
+
+        // Ticked banks stay loaded for instant program changes
+        menu.addSectionHeader("Warm set");
+        for (const auto& [program, definition] : banks)
+        {
+            menu.addItem(WARM_BANK_ITEM + program, bankLabel(program), true, definition.warm);
+            removeMenu.addItem(REMOVE_BANK_ITEM + program, bankLabel(program));
+        }
+
+        menu.addSeparator();
+        menu.addSubMenu("Remove", removeMenu);
+    }
+
+    juce::Component::SafePointer<OmniverseAudioProcessorEditor> safeThis(this);
+    menu.showMenuAsync(juce::PopupMenu::Options().withTargetComponent(&bankButton),
+                       [safeThis](int result)
+    {
+        if (safeThis == nullptr || result == 0)
+            return;
+
+        auto& processor = safeThis->processorRef;
+
+        if (result >= REMOVE_BANK_ITEM)
+        {
+            processor.removeBank(result - REMOVE_BANK_ITEM);
+        }
+        else if (result >= WARM_BANK_ITEM)
+        {
+            int program = result - WARM_BANK_ITEM;
+            auto it = processor.getBankDefinitions().find(program);
+            if (it != processor.getBankDefinitions().end())
+                processor.setBankWarm(program, !it->second.warm);
+        }
+        else
+        {
+            safeThis->storeBankAs(result - STORE_BANK_ITEM);
+        }
+    });
+}
+
+void OmniverseAudioProcessorEditor::storeBankAs(int program)
+{
+    const auto& banks = processorRef.getBankDefinitions();
+    auto existing = banks.find(program);
+    bool warm = existing != banks.end() && existing->second.warm;
+
+    auto* window = new juce::AlertWindow("Store bank", "Program " + juce::String(program + 1),
+                                         juce::MessageBoxIconType::NoIcon, this);
+    window->addTextEditor("name", existing != banks.end() ? existing->second.name
+                                                          : "Bank " + juce::String(program + 1));
+    window->addButton("Store", 1, juce::KeyPress(juce::KeyPress::returnKey));
+    window->addButton("Cancel", 0, juce::KeyPress(juce::KeyPress::escapeKey));
+
+    juce::Component::SafePointer<OmniverseAudioProcessorEditor> safeThis(this);
+    window->enterModalState(true, juce::ModalCallbackFunction::create([safeThis, window, program, warm](int result)
+    {
+        if (safeThis != nullptr && result == 1)
+            safeThis->processorRef.storeBank(program, window->getTextEditorContents("name"), warm);
+    }), true);
 }
 
 void OmniverseAudioProcessorEditor::setupTabs()
@@ -114,6 +203,53 @@ void OmniverseAudioProcessorEditor::setupMasterControls()
     addAndMakeVisible(stereoWidthLabel);
 }
 
+void OmniverseAudioProcessorEditor::setupMorphControls()
+{
+    auto& apvts = processorRef.getAPVTS();
+
+    morphStoreAButton.setButtonText("A");
+    morphStoreAButton.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+    morphStoreAButton.onClick = [this]()
+    {
+        processorRef.storeMorphSnapshot(SnapshotMorph::A);
+        updateMorphButtons();
+    };
+    addAndMakeVisible(morphStoreAButton);
+
+    morphStoreBButton.setButtonText("B");
+    morphStoreBButton.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+    morphStoreBButton.onClick = [this]()
+    {
+        processorRef.storeMorphSnapshot(SnapshotMorph::B);
+        updateMorphButtons();
+    };
+    addAndMakeVisible(morphStoreBButton);
+
+    morphSlider.setSliderStyle(juce::Slider::LinearBar);
+    morphSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 50, 20);
+    morphSlider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    addAndMakeVisible(morphSlider);
+    morphAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        apvts, Parameters::MORPH, morphSlider);
+
+    morphLabel.setText("morph", juce::dontSendNotification);
+    morphLabel.setFont(juce::Font(10.0f));
+    morphLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+    morphLabel.setJustificationType(juce::Justification::centred);
+    addAndMakeVisible(morphLabel);
+
+    updateMorphButtons();
+}
+
+// Stored snapshots are shown in white
+void OmniverseAudioProcessorEditor::updateMorphButtons()
+{
+    morphStoreAButton.setColour(juce::TextButton::textColourOffId,
+                                processorRef.hasMorphSnapshot(SnapshotMorph::A) ? juce::Colours::white : juce::Colours::grey);
+    morphStoreBButton.setColour(juce::TextButton::textColourOffId,
+                                processorRef.hasMorphSnapshot(SnapshotMorph::B) ? juce::Colours::white : juce::Colours::grey);
+}
+
 void OmniverseAudioProcessorEditor::setupPlaybackModes()
 {
     auto& apvts = processorRef.getAPVTS();
@@ -141,15 +277,96 @@ void OmniverseAudioProcessorEditor::setupPlaybackModes()
     addAndMakeVisible(reverseButton);
     reverseAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         apvts, Parameters::REVERSE, reverseButton);
+
+    bendRangeSlider.setSliderStyle(juce::Slider::LinearBar);
+    bendRangeSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 50, 20);
+    bendRangeSlider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    bendRangeSlider.setTextValueSuffix(" st");
+    addAndMakeVisible(bendRangeSlider);
+    bendRangeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        apvts, Parameters::PITCH_BEND_RANGE, bendRangeSlider);
+
+    bendRangeLabel.setText("bend range", juce::dontSendNotification);
+    bendRangeLabel.setFont(juce::Font(10.0f));
+    bendRangeLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+    addAndMakeVisible(bendRangeLabel);
+
+    glideSlider.setSliderStyle(juce::Slider::LinearBar);
+    glideSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 50, 20);
+    glideSlider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    glideSlider.setTextValueSuffix(" ms");
+    addAndMakeVisible(glideSlider);
+    glideAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        apvts, Parameters::GLIDE_TIME, glideSlider);
+
+    glideLabel.setText("glide", juce::dontSendNotification);
+    glideLabel.setFont(juce::Font(10.0f));
+    glideLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+    addAndMakeVisible(glideLabel);
+
+    silenceFloorSlider.setSliderStyle(juce::Slider::LinearBar);
+    silenceFloorSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 50, 20);
+    silenceFloorSlider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+    silenceFloorSlider.setTextValueSuffix(" dB");
+    addAndMakeVisible(silenceFloorSlider);
+    silenceFloorAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+        apvts, Parameters::SILENCE_FLOOR, silenceFloorSlider);
+
+    silenceFloorLabel.setText("silence floor", juce::dontSendNotification);
+    silenceFloorLabel.setFont(juce::Font(10.0f));
+    silenceFloorLabel.setColour(juce::Label::textColourId, juce::Colours::grey);
+    addAndMakeVisible(silenceFloorLabel);
+
+    adaptiveQualityButton.setButtonText("adaptive quality");
+    adaptiveQualityButton.setColour(juce::ToggleButton::textColourId, juce::Colours::white);
+    addAndMakeVisible(adaptiveQualityButton);
+    adaptiveQualityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        apvts, Parameters::ADAPTIVE_QUALITY, adaptiveQualityButton);
 }
 
 void OmniverseAudioProcessorEditor::setupSlotPanels()
 {
-    for (int i = 0; i < 5; ++i)
+    for (int i = 0; i < Parameters::NUM_SLOTS; ++i)
     {
         slotPanels[i] = std::make_unique<SlotPanel>(processorRef, i);
-        addAndMakeVisible(*slotPanels[i]);
+        addChildComponent(*slotPanels[i]);
+    }
+
+    // Page selector, only needed when the slots don't fit on one page
+    if (NUM_SLOT_PAGES > 1)
+    {
+        for (int page = 0; page < NUM_SLOT_PAGES; ++page)
+        {
+            int first = page * SLOTS_PER_PAGE + 1;
+            int last = juce::jmin((page + 1) * SLOTS_PER_PAGE, Parameters::NUM_SLOTS);
+
+            auto& button = slotPageButtons[page];
+            button.setButtonText(first == last ? juce::String(first)
+                                               : juce::String(first) + "-" + juce::String(last));
+            button.setColour(juce::TextButton::buttonColourId, juce::Colours::transparentBlack);
+            button.onClick = [this, page]() { showSlotPage(page); };
+            addAndMakeVisible(button);
+        }
+    }
+}
+
+void OmniverseAudioProcessorEditor::showSlotPage(int page)
+{
+    int firstSlot = page * SLOTS_PER_PAGE;
+
+    for (int i = 0; i < Parameters::NUM_SLOTS; ++i)
+    {
+        slotPanels[i]->setVisible(i / SLOTS_PER_PAGE == page);
     }
+
+    for (int p = 0; p < NUM_SLOT_PAGES; ++p)
+    {
+        slotPageButtons[p].setColour(juce::TextButton::textColourOffId,
+                                     p == page ? juce::Colours::white : juce::Colours::grey);
+    }
+
+    filtersPanel->showSlots(firstSlot, SLOTS_PER_PAGE);
+    resized();
 }
 
 void OmniverseAudioProcessorEditor::paint(juce::Graphics& g)
@@ -194,13 +411,30 @@ void OmniverseAudioProcessorEditor::resized()
     stereoWidthLabel.setBounds(widthArea.getX(), 8, 80, 15);
     stereoWidthSlider.setBounds(widthArea.getX(), 25, 80, 25);
 
-    // Slot panels area (top section, ~280px)
+    bankButton.setBounds(headerArea.removeFromRight(80).reduced(5, 15));
+
+    // Morph: A/B store buttons under the label, slider beside them
+    auto morphArea = headerArea.removeFromRight(130);
+    morphLabel.setBounds(morphArea.getX(), 8, 120, 15);
+    morphStoreAButton.setBounds(morphArea.getX(), 25, 22, 25);
+    morphStoreBButton.setBounds(morphArea.getX() + 24, 25, 22, 25);
+    morphSlider.setBounds(morphArea.getX() + 50, 25, 70, 25);
+
+    // Slot page selector between the tabs and the master controls
+    int pageButtonWidth = juce::jmin(50, headerArea.getWidth() / NUM_SLOT_PAGES);
+    for (auto& button : slotPageButtons)
+        button.setBounds(headerArea.removeFromLeft(pageButtonWidth).reduced(3, 15));
+
+    // Slot panels area (top section, ~280px), one page of slots side by side
     auto slotsArea = bounds.removeFromTop(280).reduced(10, 10);
-    int slotWidth = slotsArea.getWidth() / 5;
+    int slotsOnPage = juce::jmin(SLOTS_PER_PAGE, Parameters::NUM_SLOTS);
+    int slotWidth = slotsArea.getWidth() / slotsOnPage;
 
-    for (int i = 0; i < 5; ++i)
+    for (int i = 0; i < Parameters::NUM_SLOTS; ++i)
     {
-        auto slotBounds = slotsArea.removeFromLeft(slotWidth).reduced(5, 0);
+        int column = i % SLOTS_PER_PAGE;
+        auto slotBounds = juce::Rectangle<int>(slotsArea.getX() + column * slotWidth, slotsArea.getY(),
+                                               slotWidth, slotsArea.getHeight()).reduced(5, 0);
         slotPanels[i]->setBounds(slotBounds);
     }
 
@@ -221,6 +455,19 @@ void OmniverseAudioProcessorEditor::resized()
     randomOctaveButton.setBounds(playbackArea.getX(), buttonY, 120, buttonHeight);
     buttonY += buttonHeight + 3;
     reverseButton.setBounds(playbackArea.getX(), buttonY, 120, buttonHeight);
+    buttonY += buttonHeight + 8;
+
+    // Pitch bend range and glide below the mode toggles
+    bendRangeLabel.setBounds(playbackArea.getX(), buttonY, 120, 12);
+    bendRangeSlider.setBounds(playbackArea.getX(), buttonY + 12, 120, 18);
+    buttonY += 34;
+    glideLabel.setBounds(playbackArea.getX(), buttonY, 120, 12);
+    glideSlider.setBounds(playbackArea.getX(), buttonY + 12, 120, 18);
+    buttonY += 34;
+    silenceFloorLabel.setBounds(playbackArea.getX(), buttonY, 120, 12);
+    silenceFloorSlider.setBounds(playbackArea.getX(), buttonY + 12, 120, 18);
+    buttonY += 32;
+    adaptiveQualityButton.setBounds(playbackArea.getX(), buttonY, 120, 20);
 
     // Tab content area (right side)
     auto tabContentArea = bottomArea.reduced(5);
@@ -31,6 +31,12 @@ private:
     juce::TextButton filtersTab;
     juce::TextButton effectsTab;
 
+    // Bank menu: store the slots as a program's bank, pick the warm set
+    juce::TextButton bankButton;
+    static constexpr int STORE_BANK_ITEM = 1000;
+    static constexpr int WARM_BANK_ITEM = 2000;
+    static constexpr int REMOVE_BANK_ITEM = 3000;
+
     // Master controls
     juce::Slider masterVolumeSlider;
     juce::Slider stereoWidthSlider;
@@ -39,6 +45,13 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> masterVolumeAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> stereoWidthAttachment;
 
+    // Morph: store the current settings as A or B, then move between them
+    juce::TextButton morphStoreAButton;
+    juce::TextButton morphStoreBButton;
+    juce::Slider morphSlider;
+    juce::Label morphLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> morphAttachment;
+
     // Playback mode controls
     juce::ToggleButton layerButton;
     juce::ToggleButton randomButton;
@@ -49,8 +62,30 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> randomOctaveAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> reverseAttachment;
 
-    // Slot panels (always visible at top)
-    std::array<std::unique_ptr<SlotPanel>, 5> slotPanels;
+    // Pitch bend range and glide controls
+    juce::Slider bendRangeSlider;
+    juce::Slider glideSlider;
+    juce::Label bendRangeLabel;
+    juce::Label glideLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> bendRangeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> glideAttachment;
+
+    // Level at which slots stop rendering
+    juce::Slider silenceFloorSlider;
+    juce::Label silenceFloorLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> silenceFloorAttachment;
+
+    // Lets the CPU governor lower quality under load
+    juce::ToggleButton adaptiveQualityButton;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> adaptiveQualityAttachment;
+
+    // Slot panels (always visible at top). Builds with more slots than fit
+    // side by side show them a page at a time.
+    static constexpr int SLOTS_PER_PAGE = 5;
+    static constexpr int NUM_SLOT_PAGES = (Parameters::NUM_SLOTS + SLOTS_PER_PAGE - 1) / SLOTS_PER_PAGE;
+
+    std::array<std::unique_ptr<SlotPanel>, Parameters::NUM_SLOTS> slotPanels;
+    std::array<juce::TextButton, NUM_SLOT_PAGES> slotPageButtons;
 
     // Filters panel (bottom area, shown when filters tab active)
     std::unique_ptr<FiltersPanel> filtersPanel;
@@ -59,9 +94,14 @@ private:
     std::unique_ptr<EffectsPanel> effectsPanel;
 
     void setupHeader();
+    void showBankMenu();
+    void storeBankAs(int program);
     void setupMasterControls();
+    void setupMorphControls();
+    void updateMorphButtons();
     void setupPlaybackModes();
     void setupSlotPanels();
+    void showSlotPage(int page);
     void setupTabs();
     void switchToTab(Tab tab);
 
@@ -1,5 +1,6 @@
 #include "PluginProcessor.h"
 #include "PluginEditor.h"
+#include "Sampler/SfzParser.h"
 
 OmniverseAudioProcessor::OmniverseAudioProcessor()
     : AudioProcessor(BusesProperties()
@@ -8,10 +9,685 @@ OmniverseAudioProcessor::OmniverseAudioProcessor()
 {
     formatManager.registerBasicFormats();
     sampler.setAPVTS(&apvts);
+    resolveParameterPointers();
+
+    for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+    {
+        addListenedParameter(Parameters::slotInPoint(i));
+        addListenedParameter(Parameters::slotOutPoint(i));
+        addListenedParameter(Parameters::slotLoopCrossfade(i));
+        addListenedParameter(Parameters::slotLoopSnap(i));
+        addListenedParameter(Parameters::slotSlice(i));
+        addListenedParameter(Parameters::slotLfoDepth(i));
+
+        for (int row = 0; row < Parameters::MOD_ROWS; ++row)
+        {
+            addListenedParameter(Parameters::slotModSource(i, row));
+            addListenedParameter(Parameters::slotModDestination(i, row));
+            addListenedParameter(Parameters::slotModAmount(i, row));
+        }
+    }
+
+    setupMorph();
+
+    lastActiveBank = &sampler.getActiveBank();
+    startTimer(BANK_TIMER_MS);
 }
 
 OmniverseAudioProcessor::~OmniverseAudioProcessor()
 {
+    stopTimer();
+    cancelPendingUpdate();
+    bankLoadPool.removeAllJobs(true, 5000);
+    freezePool.removeAllJobs(true, 5000);
+
+    for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+    {
+        sampler.getSlot(i)->cancelPendingZones();
+
+        for (auto& [program, bank] : loadedBanks)
+            bank->getSlot(i)->cancelPendingZones();
+        for (auto& retired : retiredBanks)
+            retired->getSlot(i)->cancelPendingZones();
+    }
+    zoneLoadPool.removeAllJobs(true, 5000);
+
+    for (const auto& parameterID : listenedParameterIDs)
+        apvts.removeParameterListener(parameterID, this);
+}
+
+void OmniverseAudioProcessor::addListenedParameter(const juce::String& parameterID)
+{
+    apvts.addParameterListener(parameterID, this);
+    listenedParameterIDs.add(parameterID);
+}
+
+OmniverseAudioProcessor::SlotUpdate OmniverseAudioProcessor::getSlotUpdate(const juce::String& parameterID)
+{
+    int slotIndex = Parameters::slotIndexFromParameterID(parameterID);
+    if (slotIndex < 0 || slotIndex >= OmniverseSampler::NUM_SLOTS)
+        return { SlotUpdate::None, -1 };
+
+    // Mod routing is recompiled by the sampler itself before its next block
+    if (parameterID.contains("_mod_") || parameterID.endsWith("_lfo_depth"))
+        return { SlotUpdate::ModRouting, slotIndex };
+
+    if (parameterID.endsWith("_slice"))
+        return { SlotUpdate::Slices, slotIndex };
+
+    return { SlotUpdate::Region, slotIndex };
+}
+
+bool OmniverseAudioProcessor::markSlotDirty(const SlotUpdate& update)
+{
+    switch (update.kind)
+    {
+        case SlotUpdate::ModRouting: sampler.invalidateModRouting(update.slotIndex); return false;
+        case SlotUpdate::Slices: sliceDirty.fetch_or(Parameters::slotBit(update.slotIndex)); return true;
+        case SlotUpdate::Region: regionDirty.fetch_or(Parameters::slotBit(update.slotIndex)); return true;
+        case SlotUpdate::None: break;
+    }
+
+    return false;
+}
+
+void OmniverseAudioProcessor::parameterChanged(const juce::String& parameterID, float /*newValue*/)
+{
+    if (markSlotDirty(getSlotUpdate(parameterID)))
+        triggerAsyncUpdate();
+}
+
+void OmniverseAudioProcessor::handleAsyncUpdate()
+{
+    updateDirtySlots();
+    installFinishedBanks();
+}
+
+void OmniverseAudioProcessor::updateDirtySlots()
+{
+    for (auto dirty = regionDirty.exchange(0); dirty != 0; dirty &= dirty - 1)
+        updateSlotRegion(std::countr_zero(dirty));
+
+    for (auto dirty = sliceDirty.exchange(0); dirty != 0; dirty &= dirty - 1)
+        updateSlotSlices(std::countr_zero(dirty));
+}
+
+void OmniverseAudioProcessor::updateSlotSlices(int slotIndex)
+{
+    auto* slot = sampler.getSlot(slotIndex);
+    if (slot == nullptr || !slot->isLoaded())
+        return;
+
+    // Transient analysis runs with the freeze renders, off the message thread
+    if (apvts.getRawParameterValue(Parameters::slotSlice(slotIndex))->load() > 0.5f)
+        freezePool.addJob([slot] { slot->detectSlices(); });
+}
+
+SampleSlot::RegionSettings OmniverseAudioProcessor::getRegionSettings(int slotIndex)
+{
+    SampleSlot::RegionSettings settings;
+    settings.inPointPercent = apvts.getRawParameterValue(Parameters::slotInPoint(slotIndex))->load();
+    settings.outPointPercent = apvts.getRawParameterValue(Parameters::slotOutPoint(slotIndex))->load();
+    settings.crossfadeMs = apvts.getRawParameterValue(Parameters::slotLoopCrossfade(slotIndex))->load();
+    settings.snapToZeroCrossing = apvts.getRawParameterValue(Parameters::slotLoopSnap(slotIndex))->load() > 0.5f;
+    return settings;
+}
+
+void OmniverseAudioProcessor::updateSlotRegion(int slotIndex)
+{
+    auto* slot = sampler.getSlot(slotIndex);
+    if (slot == nullptr || !slot->isLoaded())
+        return;
+
+    slot->updatePlaybackRegion(getRegionSettings(slotIndex));
+}
+
+// === MORPH ===
+
+void OmniverseAudioProcessor::setupMorph()
+{
+    for (auto* processorParameter : getParameters())
+    {
+        auto* parameter = dynamic_cast<juce::RangedAudioParameter*>(processorParameter);
+        if (parameter == nullptr || parameter->paramID == Parameters::MORPH
+            || parameter->paramID == Parameters::ADAPTIVE_QUALITY)
+            continue;
+
+        bool listened = listenedParameterIDs.contains(parameter->paramID);
+        morphTargets.push_back({ parameter,
+                                 apvts.getRawParameterValue(parameter->paramID),
+                                 listened ? getSlotUpdate(parameter->paramID) : SlotUpdate {} });
+    }
+
+    morph.setSize(static_cast<int>(morphTargets.size()));
+}
+
+void OmniverseAudioProcessor::storeMorphSnapshot(int snapshot)
+{
+    std::vector<float> values;
+    values.reserve(morphTargets.size());
+
+    for (const auto& target : morphTargets)
+        values.push_back(target.parameter->convertTo0to1(target.value->load()));
+
+    morph.store(snapshot, values);
+}
+
+void OmniverseAudioProcessor::applyMorph()
+{
+    morph.process(params.morph->load(std::memory_order_relaxed), [this](int index, float normalised)
+    {
+        auto& target = morphTargets[static_cast<size_t>(index)];
+        float value = target.parameter->convertFrom0to1(normalised);
+
+        // Steps of choice and bool parameters often land on the same value
+        if (target.value->load(std::memory_order_relaxed) == value)
+            return;
+
+        target.value->store(value, std::memory_order_relaxed);
+
+        // Picked up by the timer; posting an async update would lock here
+        markSlotDirty(target.update);
+    });
+}
+
+// === BANKS ===
+
+void OmniverseAudioProcessor::setBank(int program, const SlotBank::Definition& definition)
+{
+    if (program < 0 || program > 127)
+        return;
+
+    bankDefinitions[program] = definition;
+
+    // Loads of the previous definition are discarded when they finish
+    bankLoadSerials.erase(program);
+
+    if (definition.warm)
+    {
+        loadBank(program, false);
+    }
+    else if (auto it = loadedBanks.find(program); it != loadedBanks.end())
+    {
+        retireBank(program, std::move(it->second));
+        loadedBanks.erase(it);
+    }
+}
+
+void OmniverseAudioProcessor::removeBank(int program)
+{
+    bankDefinitions.erase(program);
+    bankLoadSerials.erase(program);
+
+    if (auto it = loadedBanks.find(program); it != loadedBanks.end())
+    {
+        retireBank(program, std::move(it->second));
+        loadedBanks.erase(it);
+    }
+}
+
+void OmniverseAudioProcessor::setBankWarm(int program, bool warm)
+{
+    auto it = bankDefinitions.find(program);
+    if (it == bankDefinitions.end() || it->second.warm == warm)
+        return;
+
+    it->second.warm = warm;
+
+    if (warm && loadedBanks.count(program) == 0)
+        loadBank(program, false);
+
+    // A cold bank that is playing stays until it is switched away from
+    if (auto loaded = loadedBanks.find(program);
+        !warm && loaded != loadedBanks.end() && loaded->second.get() != &sampler.getActiveBank())
+    {
+        retireBank(program, std::move(loaded->second));
+        loadedBanks.erase(loaded);
+    }
+}
+
+void OmniverseAudioProcessor::storeBank(int program, const juce::String& name, bool warm)
+{
+    SlotBank::Definition definition;
+    definition.name = name;
+    definition.warm = warm;
+
+    // Each slot's main sample, or its instrument file
+    for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+    {
+        auto* slot = sampler.getSlot(i);
+        if (slot == nullptr || !slot->isLoaded())
+            continue;
+
+        definition.files[static_cast<size_t>(i)] = juce::File(slot->getInstrumentPath().isNotEmpty()
+                                                                  ? slot->getInstrumentPath()
+                                                                  : slot->getFilePath());
+
+        // Zones added one by one have no file to come back from
+        if (slot->getInstrumentPath().isEmpty() && slot->getNumZones() > 1)
+        {
+            for (int z = 0; z < slot->getNumZones(); ++z)
+            {
+                if (const auto* zone = slot->getZone(z))
+                    definition.zones[static_cast<size_t>(i)].push_back({ juce::File(zone->filePath), zone->mapping });
+            }
+        }
+    }
+
+    setBank(program, definition);
+}
+
+void OmniverseAudioProcessor::loadBank(int program, bool activate)
+{
+    auto it = bankDefinitions.find(program);
+    if (it == bankDefinitions.end())
+        return;
+
+    int serial = ++nextBankLoadSerial;
+    bankLoadSerials[program] = serial;
+
+    bankLoadPool.addJob([this, program, serial, activate, definition = it->second, sampleRate = getSampleRate()]
+    {
+        auto bank = std::make_unique<SlotBank>(definition.name);
+
+        for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+            loadBankSlot(*bank->getSlot(i), i, definition, sampleRate);
+
+        {
+            const juce::ScopedLock lock(finishedBanksLock);
+            finishedBanks.push_back({ program, serial, activate, std::move(bank) });
+        }
+
+        triggerAsyncUpdate();
+    });
+}
+
+void OmniverseAudioProcessor::loadBankSlot(SampleSlot& slot, int slotIndex, const SlotBank::Definition& definition,
+                                           double sampleRate)
+{
+    const auto& file = definition.files[static_cast<size_t>(slotIndex)];
+    const auto& zones = definition.zones[static_cast<size_t>(slotIndex)];
+
+    // Runs on bankLoadPool. Nothing plays from the bank yet, so instruments
+    // are read in full rather than preloaded.
+    if (!zones.empty())
+    {
+        for (const auto& zone : zones)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(zone.file));
+
+            if (reader != nullptr)
+                slot.addZone(zone.file, *reader, sampleRate, zone.mapping);
+        }
+    }
+    else if (!file.existsAsFile())
+    {
+        return;
+    }
+    else if (file.hasFileExtension("sfz"))
+    {
+        for (const auto& region : SfzParser::parse(file))
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(region.sample));
+
+            if (reader != nullptr)
+                slot.addZone(region.sample, *reader, sampleRate, region.mapping);
+        }
+
+        if (slot.isLoaded())
+            slot.setInstrumentFile(file);
+    }
+    else
+    {
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+        if (reader != nullptr)
+            slot.loadFromFile(file, *reader, sampleRate);
+    }
+
+    if (!slot.isLoaded())
+        return;
+
+    slot.updatePlaybackRegion(getRegionSettings(slotIndex));
+
+    if (apvts.getRawParameterValue(Parameters::slotSlice(slotIndex))->load() > 0.5f)
+        slot.detectSlices();
+}
+
+void OmniverseAudioProcessor::installFinishedBanks()
+{
+    std::vector<FinishedBank> finished;
+
+    {
+        const juce::ScopedLock lock(finishedBanksLock);
+        finished.swap(finishedBanks);
+    }
+
+    for (auto& result : finished)
+    {
+        // Superseded or removed while loading; never published, so freed right away
+        auto serial = bankLoadSerials.find(result.program);
+        if (serial == bankLoadSerials.end() || serial->second != result.serial)
+            continue;
+
+        bankLoadSerials.erase(serial);
+
+        // Assigned before the old bank is retired; retiring only unassigns a
+        // program that still has the old bank. If the assignment can't be
+        // sent, the audio thread never saw the new bank: it is freed right
+        // away and the old one stays.
+        EngineCommand assign;
+        assign.type = EngineCommand::Type::AssignBank;
+        assign.index = result.program;
+        assign.bank = result.bank.get();
+
+        if (!sendEngineCommand(assign))
+            continue;
+
+        // Which bank is active is only known once queued selections are applied
+        auto& entry = loadedBanks[result.program];
+        if (entry != nullptr)
+            waitForEngineCommands();
+
+        bool replacesActive = entry != nullptr && entry.get() == &sampler.getActiveBank();
+
+        if (entry != nullptr)
+            retireBank(result.program, std::move(entry));
+
+        entry = std::move(result.bank);
+
+        // The active bank's replacement takes over, or the sampler would go
+        // on playing a retired bank
+        if (result.activate || replacesActive)
+        {
+            EngineCommand select;
+            select.type = EngineCommand::Type::SelectBank;
+            select.bank = entry.get();
+            sendEngineCommand(select);
+        }
+    }
+}
+
+void OmniverseAudioProcessor::retireBank(int program, std::unique_ptr<SlotBank> bank)
+{
+    for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+        bank->getSlot(i)->cancelPendingZones();
+
+    // The audio thread unassigns it and hands it back once it's idle
+    EngineCommand command;
+    command.type = EngineCommand::Type::RetireBank;
+    command.index = program;
+    command.bank = bank.get();
+    command.retiredBank = std::move(bank);
+
+    if (!sendEngineCommand(command))
+        undeliveredBanks.push_back(std::move(command.retiredBank));
+}
+
+void OmniverseAudioProcessor::freeRetiredBanks()
+{
+    RetiredObject retired;
+    while (retiredObjects.pop(retired))
+        retiredBanks.push_back(std::move(retired.bank));
+
+    // Background jobs hold raw slot pointers, so wait for them too
+    if (freezePool.getNumJobs() == 0 && zoneLoadPool.getNumJobs() == 0)
+        retiredBanks.clear();
+}
+
+void OmniverseAudioProcessor::collectRetiredSlotData(SlotBank& bank)
+{
+    for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+    {
+        auto data = bank.getSlot(i)->takeRetiredData();
+        if (!data.isEmpty())
+            retiredSlotData.push_back({ audioEpoch.load(), std::move(data) });
+    }
+}
+
+void OmniverseAudioProcessor::freeRetiredSlotData()
+{
+    // Slot data of banks that are already retired goes with the bank
+    collectRetiredSlotData(sampler.getDefaultBank());
+    for (auto& [program, bank] : loadedBanks)
+        collectRetiredSlotData(*bank);
+
+    // Voices take slot data afresh every block, so data retired between
+    // blocks, or during a block that has since ended, is unreachable
+    auto epoch = audioEpoch.load();
+    std::erase_if(retiredSlotData, [epoch](const RetiredSlotData& retired)
+    {
+        return (retired.epoch & 1) == 0 || epoch > retired.epoch;
+    });
+}
+
+// === ENGINE COMMANDS ===
+
+bool OmniverseAudioProcessor::sendEngineCommand(EngineCommand& command)
+{
+    auto deadline = juce::Time::getMillisecondCounter() + COMMAND_TIMEOUT_MS;
+
+    while (!engineCommands.push(command))
+    {
+        if (!isAudioRunning() || juce::Time::getMillisecondCounter() >= deadline)
+        {
+            jassertfalse;
+            return false;
+        }
+
+        juce::Thread::sleep(1);
+    }
+
+    ++engineCommandsSent;
+    return true;
+}
+
+bool OmniverseAudioProcessor::waitForEngineCommands()
+{
+    auto deadline = juce::Time::getMillisecondCounter() + COMMAND_TIMEOUT_MS;
+
+    while (engineCommandsApplied.load(std::memory_order_acquire) < engineCommandsSent)
+    {
+        if (!isAudioRunning())
+            return true;
+
+        if (juce::Time::getMillisecondCounter() >= deadline)
+            return false;
+
+        juce::Thread::sleep(1);
+    }
+
+    return true;
+}
+
+bool OmniverseAudioProcessor::isAudioRunning()
+{
+    if (!engineRunning.load())
+        return false;
+
+    auto epoch = audioEpoch.load();
+    auto now = juce::Time::getMillisecondCounter();
+
+    if (epoch != lastSeenAudioEpoch)
+    {
+        lastSeenAudioEpoch = epoch;
+        lastAudioEpochChangeMs = now;
+    }
+
+    // A block that is still running counts, however long it takes
+    return (epoch & 1) != 0 || now - lastAudioEpochChangeMs < AUDIO_STALL_MS;
+}
+
+void OmniverseAudioProcessor::applyEngineCommands()
+{
+    // Retired banks go back once nothing plays from them
+    for (auto& bank : retiringBanks)
+    {
+        if (bank == nullptr || sampler.isBankInUse(bank.get()))
+            continue;
+
+        RetiredObject retired { std::move(bank) };
+        if (!retiredObjects.push(retired))
+            bank = std::move(retired.bank);
+    }
+
+    // A command that couldn't be applied yet is held here, never dropped
+    while (hasDeferredCommand || engineCommands.pop(deferredCommand))
+    {
+        hasDeferredCommand = true;
+
+        if (!applyEngineCommand(deferredCommand))
+            break;
+
+        hasDeferredCommand = false;
+        engineCommandsApplied.fetch_add(1, std::memory_order_release);
+    }
+}
+
+bool OmniverseAudioProcessor::applyEngineCommand(EngineCommand& command)
+{
+    switch (command.type)
+    {
+        case EngineCommand::Type::AssignBank:
+            sampler.setProgramBank(command.index, command.bank);
+            break;
+
+        case EngineCommand::Type::SelectBank:
+            sampler.selectBank(command.bank);
+            break;
+
+        case EngineCommand::Type::RetireBank:
+        {
+            sampler.unassignProgramBank(command.index, command.bank);
+
+            auto free = std::find(retiringBanks.begin(), retiringBanks.end(), nullptr);
+            jassert(free != retiringBanks.end());
+            if (free == retiringBanks.end())
+                return false;
+
+            *free = std::move(command.retiredBank);
+            break;
+        }
+
+        case EngineCommand::Type::SuspendSlot:
+            sampler.suspendSlot(command.bank, command.index);
+            break;
+
+        case EngineCommand::Type::ResumeSlot:
+            sampler.resumeSlot(command.bank, command.index);
+            break;
+    }
+
+    return true;
+}
+
+OmniverseAudioProcessor::ScopedSlotEdit::ScopedSlotEdit(OmniverseAudioProcessor& owner, int slotIndex)
+    : processor(owner)
+    , bank(&owner.sampler.getActiveBank())
+    , index(slotIndex)
+    , slot(bank->getSlot(slotIndex))
+{
+    // This edit's resume supersedes one still waiting for the same slot,
+    // which would otherwise land in the middle of it
+    auto& failed = processor.failedResumes;
+    failed.erase(std::remove_if(failed.begin(), failed.end(), [this](const EngineCommand& resume) {
+        return resume.bank == bank && resume.index == index;
+    }), failed.end());
+
+    EngineCommand command;
+    command.type = EngineCommand::Type::SuspendSlot;
+    command.index = index;
+    command.bank = bank;
+
+    sent = processor.sendEngineCommand(command);
+    suspended = sent && processor.waitForEngineCommands();
+}
+
+OmniverseAudioProcessor::ScopedSlotEdit::~ScopedSlotEdit()
+{
+    // Even if the suspension timed out, it is still queued and needs undoing
+    if (!sent)
+        return;
+
+    EngineCommand command;
+    command.type = EngineCommand::Type::ResumeSlot;
+    command.index = index;
+    command.bank = bank;
+
+    if (!processor.sendEngineCommand(command))
+        processor.failedResumes.push_back(std::move(command));
+}
+
+void OmniverseAudioProcessor::retryFailedResumes()
+{
+    auto sentUpTo = failedResumes.begin();
+    while (sentUpTo != failedResumes.end() && sendEngineCommand(*sentUpTo))
+        ++sentUpTo;
+
+    failedResumes.erase(failedResumes.begin(), sentUpTo);
+}
+
+void OmniverseAudioProcessor::timerCallback()
+{
+    // Suspended slots whose resume couldn't be queued
+    retryFailedResumes();
+
+    // Slots the morph changed
+    updateDirtySlots();
+
+    // Program changes for banks that weren't loaded
+    int program = sampler.takeRequestedProgram();
+    if (program >= 0 && bankDefinitions.count(program) > 0)
+        loadBank(program, true);
+
+    auto* activeBank = &sampler.getActiveBank();
+    if (activeBank != lastActiveBank)
+    {
+        lastActiveBank = activeBank;
+
+        // Region and slice settings may have changed while the bank was inactive
+        for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+        {
+            updateSlotRegion(i);
+
+            if (sampler.getSlot(i)->getNumSlices() == 0)
+                updateSlotSlices(i);
+        }
+
+        // Cold banks are only kept while they are playing
+        for (auto it = loadedBanks.begin(); it != loadedBanks.end();)
+        {
+            auto definition = bankDefinitions.find(it->first);
+            bool warm = definition != bankDefinitions.end() && definition->second.warm;
+
+            if (!warm && it->second.get() != activeBank)
+            {
+                retireBank(it->first, std::move(it->second));
+                it = loadedBanks.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+    }
+
+    freeRetiredBanks();
+    freeRetiredSlotData();
+    logGovernorEvents();
+}
+
+void OmniverseAudioProcessor::logGovernorEvents()
+{
+    CpuGovernor::Event event;
+    while (governor.popEvent(event))
+    {
+        juce::Logger::writeToLog("Omniverse: " + juce::String(event.toLevel > event.fromLevel ? "load" : "headroom")
+                                 + " at " + juce::String(juce::roundToInt(event.load * 100.0f)) + "% of the block budget"
+                                 + " (t=" + juce::String(event.timeSeconds, 1) + "s), quality level "
+                                 + juce::String(event.fromLevel) + " -> " + juce::String(event.toLevel)
+                                 + ": " + OmniverseSampler::getQualityLevelName(event.toLevel));
+    }
 }
 
 const juce::String OmniverseAudioProcessor::getName() const
@@ -66,33 +742,48 @@ void OmniverseAudioProcessor::changeProgramName(int index, const juce::String& n
     juce::ignoreUnused(index, newName);
 }
 
-void OmniverseAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
+void OmniverseAudioProcessor::prepareToPlay(double sampleRate, int /*samplesPerBlock*/)
 {
     sampler.setCurrentPlaybackSampleRate(sampleRate);
+    governor.prepare(sampleRate);
+
+    // Everything below only ever sees micro-blocks
+    microBlock.setSize(getTotalNumOutputChannels(), MICRO_BLOCK_SIZE);
+    microBlock.clear();
+    microBlockPosition = MICRO_BLOCK_SIZE;
+    // The micro-block, plus the delay every slot filter type and bypass share
+    setLatencySamples(MICRO_BLOCK_SIZE + SVFilter::LATENCY);
+
+    pendingMidi.clear();
+    pendingMidi.ensureSize(MIDI_RESERVE_BYTES);
+    laterMidi.ensureSize(MIDI_RESERVE_BYTES);
+    microBlockMidi.ensureSize(MIDI_RESERVE_BYTES);
+
+    // Start the ramps at the current values rather than gliding in
+    lastMasterVolumeDb = params.masterVolume->load();
+    masterGainRamp.setTarget(juce::Decibels::decibelsToGain(lastMasterVolumeDb));
+    masterGainRamp.prepare(sampleRate, MICRO_BLOCK_SIZE);
+    stereoWidthRamp.setTarget(params.stereoWidth->load() / 100.0f);
+    stereoWidthRamp.prepare(sampleRate, MICRO_BLOCK_SIZE);
+    midSideScratch.setSize(2, MICRO_BLOCK_SIZE);
 
     for (int i = 0; i < sampler.getNumVoices(); ++i)
     {
         if (auto* voice = dynamic_cast<OmniverseVoice*>(sampler.getVoice(i)))
         {
-            voice->prepareToPlay(sampleRate, samplesPerBlock);
+            voice->prepareToPlay(sampleRate, MICRO_BLOCK_SIZE);
         }
     }
 
-    // Prepare BBD Delay
-    bbdDelay.prepare(sampleRate, samplesPerBlock);
+    updateEffectBypass();
+    effectChain.prepare(sampleRate, MICRO_BLOCK_SIZE);
 
-    // Prepare BBD Chorus
-    bbdChorus.prepare(sampleRate, samplesPerBlock);
-
-    // Prepare Tape Saturation
-    tapeSaturation.prepare(sampleRate, samplesPerBlock);
-
-    // Prepare Spectral Filter
-    spectralFilter.prepare(sampleRate, samplesPerBlock);
+    engineRunning.store(true);
 }
 
 void OmniverseAudioProcessor::releaseResources()
 {
+    engineRunning.store(false);
 }
 
 bool OmniverseAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
@@ -104,124 +795,297 @@ bool OmniverseAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts)
     return true;
 }
 
+void OmniverseAudioProcessor::resolveParameterPointers()
+{
+    auto get = [this](const juce::String& id)
+    {
+        auto* parameter = apvts.getRawParameterValue(id);
+        jassert(parameter != nullptr);
+        return parameter;
+    };
+
+    params.masterVolume = get(Parameters::MASTER_VOLUME);
+    params.stereoWidth = get(Parameters::STEREO_WIDTH);
+    params.morph = get(Parameters::MORPH);
+    params.adaptiveQuality = get(Parameters::ADAPTIVE_QUALITY);
+
+    params.delayTime = get(Parameters::DELAY_TIME);
+    params.delayFeedback = get(Parameters::DELAY_FEEDBACK);
+    params.delayModDepth = get(Parameters::DELAY_MOD_DEPTH);
+    params.delayModRate = get(Parameters::DELAY_MOD_RATE);
+    params.delayTone = get(Parameters::DELAY_TONE);
+    params.delayMix = get(Parameters::DELAY_MIX);
+    params.delayBypass = get(Parameters::DELAY_BYPASS);
+
+    params.chorusRate = get(Parameters::CHORUS_RATE);
+    params.chorusDepth = get(Parameters::CHORUS_DEPTH);
+    params.chorusTone = get(Parameters::CHORUS_TONE);
+    params.chorusMix = get(Parameters::CHORUS_MIX);
+    params.chorusBypass = get(Parameters::CHORUS_BYPASS);
+
+    params.tapeDrive = get(Parameters::TAPE_DRIVE);
+    params.tapeCompression = get(Parameters::TAPE_COMPRESSION);
+    params.tapeTone = get(Parameters::TAPE_TONE);
+    params.tapeMix = get(Parameters::TAPE_MIX);
+    params.tapeBypass = get(Parameters::TAPE_BYPASS);
+
+    params.spectralLow = get(Parameters::SPECTRAL_LOW);
+    params.spectralMid = get(Parameters::SPECTRAL_MID);
+    params.spectralHigh = get(Parameters::SPECTRAL_HIGH);
+    params.spectralSpread = get(Parameters::SPECTRAL_SPREAD);
+    params.spectralMix = get(Parameters::SPECTRAL_MIX);
+    params.spectralBypass = get(Parameters::SPECTRAL_BYPASS);
+
+    params.effectChain = get(Parameters::EFFECT_CHAIN);
+    params.effectOrder = get(Parameters::EFFECT_ORDER);
+    params.branchLevels[EffectChain::Delay] = get(Parameters::DELAY_BRANCH_LEVEL);
+    params.branchLevels[EffectChain::Chorus] = get(Parameters::CHORUS_BRANCH_LEVEL);
+    params.branchLevels[EffectChain::Tape] = get(Parameters::TAPE_BRANCH_LEVEL);
+    params.branchLevels[EffectChain::Spectral] = get(Parameters::SPECTRAL_BRANCH_LEVEL);
+}
+
+void OmniverseAudioProcessor::updateEffectBypass()
+{
+    effectChain.setEnabled(EffectChain::Delay, !isOn(params.delayBypass));
+    effectChain.setEnabled(EffectChain::Chorus, !isOn(params.chorusBypass));
+    effectChain.setEnabled(EffectChain::Tape, !isOn(params.tapeBypass));
+    effectChain.setEnabled(EffectChain::Spectral, !isOn(params.spectralBypass));
+}
+
 void OmniverseAudioProcessor::updateDelayParameters()
 {
-    bbdDelay.setDelayTime(apvts.getRawParameterValue(Parameters::DELAY_TIME)->load());
-    bbdDelay.setFeedback(apvts.getRawParameterValue(Parameters::DELAY_FEEDBACK)->load());
-    bbdDelay.setModDepth(apvts.getRawParameterValue(Parameters::DELAY_MOD_DEPTH)->load());
-    bbdDelay.setModRate(apvts.getRawParameterValue(Parameters::DELAY_MOD_RATE)->load());
-    bbdDelay.setTone(apvts.getRawParameterValue(Parameters::DELAY_TONE)->load());
-    bbdDelay.setMix(apvts.getRawParameterValue(Parameters::DELAY_MIX)->load());
+    DelaySettings settings { params.delayTime->load(std::memory_order_relaxed),
+                             params.delayFeedback->load(std::memory_order_relaxed),
+                             params.delayModDepth->load(std::memory_order_relaxed),
+                             params.delayModRate->load(std::memory_order_relaxed),
+                             params.delayTone->load(std::memory_order_relaxed),
+                             params.delayMix->load(std::memory_order_relaxed) };
+
+    if (lastDelaySettings == settings)
+        return;
+
+    lastDelaySettings = settings;
+    auto& delay = effectChain.getDelay();
+    delay.setDelayTime(settings.time);
+    delay.setFeedback(settings.feedback);
+    delay.setModDepth(settings.modDepth);
+    delay.setModRate(settings.modRate);
+    delay.setTone(settings.tone);
+    delay.setMix(settings.mix);
 }
 
 void OmniverseAudioProcessor::updateChorusParameters()
 {
-    bbdChorus.setRate(apvts.getRawParameterValue(Parameters::CHORUS_RATE)->load());
-    bbdChorus.setDepth(apvts.getRawParameterValue(Parameters::CHORUS_DEPTH)->load());
-    bbdChorus.setTone(apvts.getRawParameterValue(Parameters::CHORUS_TONE)->load());
-    bbdChorus.setMix(apvts.getRawParameterValue(Parameters::CHORUS_MIX)->load());
+    ChorusSettings settings { params.chorusRate->load(std::memory_order_relaxed),
+                              params.chorusDepth->load(std::memory_order_relaxed),
+                              params.chorusTone->load(std::memory_order_relaxed),
+                              params.chorusMix->load(std::memory_order_relaxed) };
+
+    if (lastChorusSettings == settings)
+        return;
+
+    lastChorusSettings = settings;
+    auto& chorus = effectChain.getChorus();
+    chorus.setRate(settings.rate);
+    chorus.setDepth(settings.depth);
+    chorus.setTone(settings.tone);
+    chorus.setMix(settings.mix);
 }
 
 void OmniverseAudioProcessor::updateTapeParameters()
 {
-    tapeSaturation.setDrive(apvts.getRawParameterValue(Parameters::TAPE_DRIVE)->load());
-    tapeSaturation.setCompression(apvts.getRawParameterValue(Parameters::TAPE_COMPRESSION)->load());
-    tapeSaturation.setTone(apvts.getRawParameterValue(Parameters::TAPE_TONE)->load());
-    tapeSaturation.setMix(apvts.getRawParameterValue(Parameters::TAPE_MIX)->load());
+    TapeSettings settings { params.tapeDrive->load(std::memory_order_relaxed),
+                            params.tapeCompression->load(std::memory_order_relaxed),
+                            params.tapeTone->load(std::memory_order_relaxed),
+                            params.tapeMix->load(std::memory_order_relaxed) };
+
+    if (lastTapeSettings == settings)
+        return;
+
+    lastTapeSettings = settings;
+    auto& tape = effectChain.getTape();
+    tape.setDrive(settings.drive);
+    tape.setCompression(settings.compression);
+    tape.setTone(settings.tone);
+    tape.setMix(settings.mix);
 }
 
 void OmniverseAudioProcessor::updateSpectralParameters()
 {
-    spectralFilter.setLowGain(apvts.getRawParameterValue(Parameters::SPECTRAL_LOW)->load());
-    spectralFilter.setMidGain(apvts.getRawParameterValue(Parameters::SPECTRAL_MID)->load());
-    spectralFilter.setHighGain(apvts.getRawParameterValue(Parameters::SPECTRAL_HIGH)->load());
-    spectralFilter.setSpread(apvts.getRawParameterValue(Parameters::SPECTRAL_SPREAD)->load());
-    spectralFilter.setMix(apvts.getRawParameterValue(Parameters::SPECTRAL_MIX)->load());
+    SpectralSettings settings { params.spectralLow->load(std::memory_order_relaxed),
+                                params.spectralMid->load(std::memory_order_relaxed),
+                                params.spectralHigh->load(std::memory_order_relaxed),
+                                params.spectralSpread->load(std::memory_order_relaxed),
+                                params.spectralMix->load(std::memory_order_relaxed) };
+
+    if (lastSpectralSettings == settings)
+        return;
+
+    lastSpectralSettings = settings;
+    auto& spectral = effectChain.getSpectral();
+    spectral.setLowGain(settings.low);
+    spectral.setMidGain(settings.mid);
+    spectral.setHighGain(settings.high);
+    spectral.setSpread(settings.spread);
+    spectral.setMix(settings.mix);
+}
+
+void OmniverseAudioProcessor::updateChainTopology()
+{
+    ChainSettings settings { juce::roundToInt(params.effectChain->load(std::memory_order_relaxed)),
+                             juce::roundToInt(params.effectOrder->load(std::memory_order_relaxed)),
+                             {} };
+
+    for (size_t i = 0; i < settings.branchLevels.size(); ++i)
+        settings.branchLevels[i] = params.branchLevels[i]->load(std::memory_order_relaxed);
+
+    if (lastChainSettings == settings)
+        return;
+
+    lastChainSettings = settings;
+
+    // Chain choice: Serial, Parallel, Custom
+    EffectChain::Topology topology;
+    topology.mode = settings.chain == 1 ? EffectChain::Mode::Parallel : EffectChain::Mode::Serial;
+    topology.order = EffectOrder::getOrder(settings.chain == 2 ? settings.order : 0);
+    topology.branchGains = settings.branchLevels;
+    effectChain.setTopology(topology);
 }
 
 void OmniverseAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    auto startTicks = juce::Time::getHighResolutionTicks();
+    audioEpoch.fetch_add(1);
 
-    buffer.clear();
-    sampler.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
+    // Structural edits first, so this block's notes already see them
+    applyEngineCommands();
 
-    // Update and apply BBD Delay (if not bypassed)
-    bool delayBypassed = apvts.getRawParameterValue(Parameters::DELAY_BYPASS)->load() > 0.5f;
+    // Quality follows the governor's level from the previous blocks
+    bool adaptiveQuality = isOn(params.adaptiveQuality);
+    if (!adaptiveQuality)
+        governor.reset();
+    sampler.setQualityLevel(governor.getLevel());
 
-    if (!delayBypassed && buffer.getNumChannels() >= 2)
+    // Events keep their sample position, counted from the start of the next
+    // micro-block to render
+    pendingMidi.addEvents(midiMessages, 0, -1, microBlockPosition);
+
+    const int numSamples = buffer.getNumSamples();
+    const int numChannels = std::min(buffer.getNumChannels(), microBlock.getNumChannels());
+
+    for (int position = 0; position < numSamples;)
     {
-        updateDelayParameters();
+        if (microBlockPosition == MICRO_BLOCK_SIZE)
+        {
+            renderMicroBlock();
+            microBlockPosition = 0;
+        }
 
-        float* leftChannel = buffer.getWritePointer(0);
-        float* rightChannel = buffer.getWritePointer(1);
+        int count = std::min(numSamples - position, MICRO_BLOCK_SIZE - microBlockPosition);
 
-        bbdDelay.processBlock(leftChannel, rightChannel, buffer.getNumSamples());
+        for (int channel = 0; channel < numChannels; ++channel)
+            buffer.copyFrom(channel, position, microBlock, channel, microBlockPosition, count);
+
+        microBlockPosition += count;
+        position += count;
     }
 
-    // Update and apply BBD Chorus (if not bypassed)
-    bool chorusBypassed = apvts.getRawParameterValue(Parameters::CHORUS_BYPASS)->load() > 0.5f;
+    for (int channel = numChannels; channel < buffer.getNumChannels(); ++channel)
+        buffer.clear(channel, 0, numSamples);
 
-    if (!chorusBypassed && buffer.getNumChannels() >= 2)
+    if (adaptiveQuality)
     {
-        updateChorusParameters();
-
-        float* leftChannel = buffer.getWritePointer(0);
-        float* rightChannel = buffer.getWritePointer(1);
-
-        bbdChorus.processBlock(leftChannel, rightChannel, buffer.getNumSamples());
+        auto elapsed = juce::Time::highResolutionTicksToSeconds(juce::Time::getHighResolutionTicks() - startTicks);
+        governor.update(elapsed, numSamples);
     }
 
-    // Update and apply Tape Saturation (if not bypassed)
-    bool tapeBypassed = apvts.getRawParameterValue(Parameters::TAPE_BYPASS)->load() > 0.5f;
+    audioEpoch.fetch_add(1);
+}
 
-    if (!tapeBypassed && buffer.getNumChannels() >= 2)
-    {
-        updateTapeParameters();
+void OmniverseAudioProcessor::renderMicroBlock()
+{
+    // Split off this block's events; the rest move one block closer
+    microBlockMidi.clear();
+    microBlockMidi.addEvents(pendingMidi, 0, MICRO_BLOCK_SIZE, 0);
+    laterMidi.clear();
+    laterMidi.addEvents(pendingMidi, MICRO_BLOCK_SIZE, -1, -MICRO_BLOCK_SIZE);
+    pendingMidi.swapWith(laterMidi);
 
-        float* leftChannel = buffer.getWritePointer(0);
-        float* rightChannel = buffer.getWritePointer(1);
+    auto& buffer = microBlock;
 
-        tapeSaturation.processBlock(leftChannel, rightChannel, buffer.getNumSamples());
-    }
+    buffer.clear();
+    applyMorph();
+    sampler.compileModRouting();
+    sampler.renderNextBlock(buffer, microBlockMidi, 0, buffer.getNumSamples());
 
-    // Update and apply Spectral Filter (if not bypassed)
-    bool spectralBypassed = apvts.getRawParameterValue(Parameters::SPECTRAL_BYPASS)->load() > 0.5f;
+    const int numSamples = buffer.getNumSamples();
 
-    if (!spectralBypassed && buffer.getNumChannels() >= 2)
+    // Effects run as a chain; bypassed ones fade out of it and then cost
+    // nothing, so only running ones need their parameters
+    if (buffer.getNumChannels() >= 2)
     {
-        updateSpectralParameters();
+        updateEffectBypass();
+
+        if (effectChain.isRunning(EffectChain::Delay))
+            updateDelayParameters();
+        if (effectChain.isRunning(EffectChain::Chorus))
+            updateChorusParameters();
+        if (effectChain.isRunning(EffectChain::Tape))
+            updateTapeParameters();
+        if (effectChain.isRunning(EffectChain::Spectral))
+            updateSpectralParameters();
+
+        updateChainTopology();
 
-        float* leftChannel = buffer.getWritePointer(0);
-        float* rightChannel = buffer.getWritePointer(1);
+        effectChain.process(buffer.getWritePointer(0), buffer.getWritePointer(1), numSamples);
+    }
 
-        spectralFilter.processBlock(leftChannel, rightChannel, buffer.getNumSamples());
+    // Apply master volume, converted only when it changes
+    float masterVolumeDb = params.masterVolume->load(std::memory_order_relaxed);
+    if (masterVolumeDb != lastMasterVolumeDb)
+    {
+        lastMasterVolumeDb = masterVolumeDb;
+        masterGainRamp.setTarget(juce::Decibels::decibelsToGain(masterVolumeDb));
     }
 
-    // Apply master volume
-    float masterVolume = juce::Decibels::decibelsToGain(
-        apvts.getRawParameterValue(Parameters::MASTER_VOLUME)->load()
-    );
-    buffer.applyGain(masterVolume);
+    if (masterGainRamp.isRamping())
+    {
+        const float* gains = masterGainRamp.fill(numSamples);
+        for (int channel = 0; channel < buffer.getNumChannels(); ++channel)
+            juce::FloatVectorOperations::multiply(buffer.getWritePointer(channel), gains, numSamples);
+    }
+    else
+    {
+        buffer.applyGain(masterGainRamp.getCurrent());
+    }
 
     // Apply stereo width (mid-side processing)
-    float stereoWidth = apvts.getRawParameterValue(Parameters::STEREO_WIDTH)->load() / 100.0f;
+    stereoWidthRamp.setTarget(params.stereoWidth->load(std::memory_order_relaxed) / 100.0f);
 
-    if (buffer.getNumChannels() == 2 && stereoWidth != 1.0f)
+    if (buffer.getNumChannels() == 2 && (stereoWidthRamp.isRamping() || stereoWidthRamp.getCurrent() != 1.0f))
     {
         auto* leftChannel = buffer.getWritePointer(0);
         auto* rightChannel = buffer.getWritePointer(1);
+        auto* mid = midSideScratch.getWritePointer(0);
+        auto* side = midSideScratch.getWritePointer(1);
 
-        for (int i = 0; i < buffer.getNumSamples(); ++i)
-        {
-            float mid = (leftChannel[i] + rightChannel[i]) * 0.5f;
-            float side = (leftChannel[i] - rightChannel[i]) * 0.5f;
-
-            side *= stereoWidth;
+        juce::FloatVectorOperations::add(mid, leftChannel, rightChannel, numSamples);
+        juce::FloatVectorOperations::multiply(mid, 0.5f, numSamples);
+        juce::FloatVectorOperations::subtract(side, leftChannel, rightChannel, numSamples);
 
-            leftChannel[i] = mid + side;
-            rightChannel[i] = mid - side;
+        if (stereoWidthRamp.isRamping())
+        {
+            juce::FloatVectorOperations::multiply(side, stereoWidthRamp.fill(numSamples), numSamples);
+            juce::FloatVectorOperations::multiply(side, 0.5f, numSamples);
         }
+        else
+        {
+            juce::FloatVectorOperations::multiply(side, 0.5f * stereoWidthRamp.getCurrent(), numSamples);
+        }
+
+        juce::FloatVectorOperations::add(leftChannel, mid, side, numSamples);
+        juce::FloatVectorOperations::subtract(rightChannel, mid, side, numSamples);
     }
 
     // Final safety pass: sanitize and soft-clip output
@@ -251,21 +1115,119 @@ juce::AudioProcessorEditor* OmniverseAudioProcessor::createEditor()
     return new OmniverseAudioProcessorEditor(*this);
 }
 
+juce::ValueTree OmniverseAudioProcessor::createZoneTree(const juce::String& filePath, const SampleSlot::ZoneMapping& mapping)
+{
+    juce::ValueTree zoneTree("Zone");
+    zoneTree.setProperty("file", filePath, nullptr);
+    zoneTree.setProperty("lowKey", mapping.lowKey, nullptr);
+    zoneTree.setProperty("highKey", mapping.highKey, nullptr);
+    zoneTree.setProperty("lowVelocity", mapping.lowVelocity, nullptr);
+    zoneTree.setProperty("highVelocity", mapping.highVelocity, nullptr);
+    zoneTree.setProperty("rootKey", mapping.rootKey, nullptr);
+    return zoneTree;
+}
+
+SampleSlot::ZoneMapping OmniverseAudioProcessor::readZoneMapping(const juce::ValueTree& zoneTree)
+{
+    SampleSlot::ZoneMapping mapping;
+    mapping.lowKey = zoneTree.getProperty("lowKey", mapping.lowKey);
+    mapping.highKey = zoneTree.getProperty("highKey", mapping.highKey);
+    mapping.lowVelocity = zoneTree.getProperty("lowVelocity", mapping.lowVelocity);
+    mapping.highVelocity = zoneTree.getProperty("highVelocity", mapping.highVelocity);
+    mapping.rootKey = zoneTree.getProperty("rootKey", mapping.rootKey);
+    return mapping;
+}
+
 void OmniverseAudioProcessor::getStateInformation(juce::MemoryBlock& destData)
 {
     auto state = apvts.copyState();
 
-    // Store sample file paths
+    // Store sample file paths, plus any zones beyond each slot's main sample
+    state.removeChild(state.getChildWithName("SlotZones"), nullptr);
+    juce::ValueTree zonesTree("SlotZones");
+
     for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
     {
         auto* slot = sampler.getSlot(i);
+        state.removeProperty(juce::Identifier("slot_" + juce::String(i) + "_instrument"), nullptr);
+
         if (slot && slot->isLoaded())
         {
             state.setProperty(juce::Identifier("slot_" + juce::String(i) + "_file"),
                              slot->getFilePath(), nullptr);
+
+            // Instruments are re-imported from their file instead
+            if (slot->getInstrumentPath().isNotEmpty())
+            {
+                state.setProperty(juce::Identifier("slot_" + juce::String(i) + "_instrument"),
+                                 slot->getInstrumentPath(), nullptr);
+                continue;
+            }
+
+            for (int z = 0; z < slot->getNumZones(); ++z)
+            {
+                const auto* zone = slot->getZone(z);
+                if (zone == nullptr)
+                    continue;
+
+                auto zoneTree = createZoneTree(zone->filePath, zone->mapping);
+                zoneTree.setProperty("slot", i, nullptr);
+                zonesTree.appendChild(zoneTree, nullptr);
+            }
+        }
+    }
+
+    state.appendChild(zonesTree, nullptr);
+
+    state.removeChild(state.getChildWithName("Banks"), nullptr);
+    juce::ValueTree banksTree("Banks");
+
+    for (const auto& [program, definition] : bankDefinitions)
+    {
+        juce::ValueTree bankTree("Bank");
+        bankTree.setProperty("program", program, nullptr);
+        bankTree.setProperty("name", definition.name, nullptr);
+        bankTree.setProperty("warm", definition.warm, nullptr);
+
+        for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+        {
+            const auto& file = definition.files[static_cast<size_t>(i)];
+            if (file != juce::File())
+                bankTree.setProperty(juce::Identifier("slot_" + juce::String(i)), file.getFullPathName(), nullptr);
+
+            for (const auto& zone : definition.zones[static_cast<size_t>(i)])
+            {
+                auto zoneTree = createZoneTree(zone.file.getFullPathName(), zone.mapping);
+                zoneTree.setProperty("slot", i, nullptr);
+                bankTree.appendChild(zoneTree, nullptr);
+            }
         }
+
+        banksTree.appendChild(bankTree, nullptr);
+    }
+
+    state.appendChild(banksTree, nullptr);
+
+    // Morph snapshots, normalised and keyed by parameter ID
+    state.removeChild(state.getChildWithName("Morph"), nullptr);
+    juce::ValueTree morphTree("Morph");
+
+    for (int snapshot : { SnapshotMorph::A, SnapshotMorph::B })
+    {
+        if (!morph.hasSnapshot(snapshot))
+            continue;
+
+        juce::ValueTree snapshotTree(snapshot == SnapshotMorph::A ? "A" : "B");
+        const auto& values = morph.getSnapshot(snapshot);
+
+        for (size_t i = 0; i < morphTargets.size(); ++i)
+            snapshotTree.setProperty(juce::Identifier(morphTargets[i].parameter->paramID), values[i], nullptr);
+
+        morphTree.appendChild(snapshotTree, nullptr);
     }
 
+    state.appendChild(morphTree, nullptr);
+
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
 }
@@ -279,9 +1241,47 @@ void OmniverseAudioProcessor::setStateInformation(const void* data, int sizeInBy
         auto state = juce::ValueTree::fromXml(*xmlState);
         apvts.replaceState(state);
 
-        // Reload samples from stored paths
+        // Reload samples from stored paths. Slots saved with zones are
+        // rebuilt zone by zone instead, main sample first.
+        auto zonesTree = state.getChildWithName("SlotZones");
+        Parameters::SlotMask zonedSlots = 0;
+        Parameters::SlotMask failedSlots = 0;
+
+        for (const auto& zoneTree : zonesTree)
+        {
+            int slotIndex = zoneTree.getProperty("slot", -1);
+            if (slotIndex < 0 || slotIndex >= OmniverseSampler::NUM_SLOTS)
+                continue;
+
+            if ((zonedSlots & Parameters::slotBit(slotIndex)) == 0)
+            {
+                // A slot that couldn't be suspended keeps what it has
+                ScopedSlotEdit edit(*this, slotIndex);
+                if (!edit.isSuspended())
+                    failedSlots |= Parameters::slotBit(slotIndex);
+                else
+                    edit.getSlot()->clear();
+
+                zonedSlots |= Parameters::slotBit(slotIndex);
+            }
+
+            if ((failedSlots & Parameters::slotBit(slotIndex)) != 0)
+                continue;
+
+            juce::File file(zoneTree.getProperty("file").toString());
+            if (file.existsAsFile())
+                addZoneToSlot(slotIndex, file, readZoneMapping(zoneTree));
+        }
+
         for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
         {
+            if ((zonedSlots & Parameters::slotBit(i)) != 0)
+                continue;
+
+            juce::File instrument(state.getProperty(juce::Identifier("slot_" + juce::String(i) + "_instrument"), "").toString());
+            if (instrument.existsAsFile() && loadSfzIntoSlot(i, instrument))
+                continue;
+
             auto filePath = state.getProperty(juce::Identifier("slot_" + juce::String(i) + "_file"), "").toString();
             if (filePath.isNotEmpty())
             {
@@ -292,6 +1292,64 @@ void OmniverseAudioProcessor::setStateInformation(const void* data, int sizeInBy
                 }
             }
         }
+
+        while (!bankDefinitions.empty())
+            removeBank(bankDefinitions.begin()->first);
+
+        for (const auto& bankTree : state.getChildWithName("Banks"))
+        {
+            SlotBank::Definition definition;
+            definition.name = bankTree.getProperty("name").toString();
+            definition.warm = bankTree.getProperty("warm", false);
+
+            for (int i = 0; i < OmniverseSampler::NUM_SLOTS; ++i)
+            {
+                auto path = bankTree.getProperty(juce::Identifier("slot_" + juce::String(i))).toString();
+                if (path.isNotEmpty())
+                    definition.files[static_cast<size_t>(i)] = juce::File(path);
+            }
+
+            for (const auto& zoneTree : bankTree)
+            {
+                int slotIndex = zoneTree.getProperty("slot", -1);
+                if (zoneTree.hasType("Zone") && slotIndex >= 0 && slotIndex < OmniverseSampler::NUM_SLOTS)
+                {
+                    definition.zones[static_cast<size_t>(slotIndex)].push_back({ juce::File(zoneTree.getProperty("file").toString()),
+                                                                                 readZoneMapping(zoneTree) });
+                }
+            }
+
+            setBank(bankTree.getProperty("program", -1), definition);
+        }
+
+        // Parameters missing from a stored snapshot take their loaded value
+        auto readSnapshot = [this](const juce::ValueTree& snapshotTree)
+        {
+            std::vector<float> values;
+            values.reserve(morphTargets.size());
+
+            for (const auto& target : morphTargets)
+                values.push_back(static_cast<float>(snapshotTree.getProperty(juce::Identifier(target.parameter->paramID),
+                                                                             target.parameter->getValue())));
+            return values;
+        };
+
+        auto morphTree = state.getChildWithName("Morph");
+        auto snapshotA = morphTree.getChildWithName("A");
+        auto snapshotB = morphTree.getChildWithName("B");
+
+        if (snapshotA.isValid() && snapshotB.isValid())
+        {
+            morph.restore(readSnapshot(snapshotA), readSnapshot(snapshotB));
+        }
+        else
+        {
+            morph.clear();
+            if (snapshotA.isValid())
+                morph.store(SnapshotMorph::A, readSnapshot(snapshotA));
+            if (snapshotB.isValid())
+                morph.store(SnapshotMorph::B, readSnapshot(snapshotB));
+        }
     }
 }
 
@@ -300,16 +1358,117 @@ bool OmniverseAudioProcessor::loadSampleIntoSlot(int slotIndex, const juce::File
     if (slotIndex < 0 || slotIndex >= OmniverseSampler::NUM_SLOTS)
         return false;
 
+    if (file.hasFileExtension("sfz"))
+        return loadSfzIntoSlot(slotIndex, file);
+
     std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
 
     if (reader == nullptr)
         return false;
 
+    {
+        ScopedSlotEdit edit(*this, slotIndex);
+        if (!edit.isSuspended() || edit.getSlot() == nullptr
+            || !edit.getSlot()->loadFromFile(file, *reader, getSampleRate()))
+            return false;
+    }
+
+    updateSlotRegion(slotIndex);
+    updateSlotSlices(slotIndex);
+    return true;
+}
+
+bool OmniverseAudioProcessor::loadSfzIntoSlot(int slotIndex, const juce::File& sfzFile)
+{
+    auto regions = SfzParser::parse(sfzFile);
+    auto* slot = sampler.getSlot(slotIndex);
+
+    if (regions.empty() || slot == nullptr)
+        return false;
+
+    {
+        ScopedSlotEdit edit(*this, slotIndex);
+        if (!edit.isSuspended())
+            return false;
+
+        slot = edit.getSlot();
+        slot->clear();
+
+        for (const auto& region : regions)
+        {
+            std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(region.sample));
+
+            if (reader != nullptr)
+                slot->addZone(region.sample, *reader, getSampleRate(), region.mapping, ZONE_PRELOAD_SECONDS);
+        }
+    }
+
+    if (!slot->isLoaded())
+        return false;
+
+    slot->setInstrumentFile(sfzFile);
+    updateSlotRegion(slotIndex);
+    updateSlotSlices(slotIndex);
+
+    int generation = slot->getLoadGeneration();
+    zoneLoadPool.addJob([this, slot, generation] { slot->completePendingZones(formatManager, generation); });
+    return true;
+}
+
+bool OmniverseAudioProcessor::addZoneToSlot(int slotIndex, const juce::File& file, const SampleSlot::ZoneMapping& mapping)
+{
     auto* slot = sampler.getSlot(slotIndex);
     if (slot == nullptr)
         return false;
 
-    return slot->loadFromFile(file, *reader, getSampleRate());
+    std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+
+    if (reader == nullptr)
+        return false;
+
+    bool wasLoaded = slot->isLoaded();
+    if (!slot->addZone(file, *reader, getSampleRate(), mapping))
+        return false;
+
+    // A first zone starts with a full-length region, like a plain load
+    if (!wasLoaded)
+    {
+        updateSlotRegion(slotIndex);
+        updateSlotSlices(slotIndex);
+    }
+
+    return true;
+}
+
+void OmniverseAudioProcessor::freezeSlot(int slotIndex)
+{
+    auto* slot = sampler.getSlot(slotIndex);
+    if (slot == nullptr || !slot->isLoaded())
+        return;
+
+    // Snapshot the settings now; the render itself happens off the message thread
+    SampleSlot::FreezeSettings settings;
+    settings.filterType = static_cast<SVFilter::Type>(static_cast<int>(apvts.getRawParameterValue(Parameters::slotFilterType(slotIndex))->load()));
+    settings.cutoffHz = apvts.getRawParameterValue(Parameters::slotFilterCutoff(slotIndex))->load();
+    settings.resonance = apvts.getRawParameterValue(Parameters::slotFilterResonance(slotIndex))->load();
+    settings.filterBypass = apvts.getRawParameterValue(Parameters::slotFilterBypass(slotIndex))->load() > 0.5f;
+    settings.lfoRate = apvts.getRawParameterValue(Parameters::slotLfoRate(slotIndex))->load();
+    settings.lfoDepth = apvts.getRawParameterValue(Parameters::slotLfoDepth(slotIndex))->load();
+    settings.lfoWaveform = static_cast<LFO::Waveform>(static_cast<int>(apvts.getRawParameterValue(Parameters::slotLfoWaveform(slotIndex))->load()));
+
+    freezePool.addJob([slot, settings] { slot->renderFreeze(settings); });
+}
+
+void OmniverseAudioProcessor::unfreezeSlot(int slotIndex)
+{
+    if (auto* slot = sampler.getSlot(slotIndex))
+        slot->unfreeze();
+}
+
+bool OmniverseAudioProcessor::isSlotFrozen(int slotIndex) const
+{
+    auto* slot = sampler.getSlot(slotIndex);
+    return slot != nullptr && slot->isFrozen();
 }
 
 juce::AudioProcessor* JUCE_CALLTYPE createPluginFilter()
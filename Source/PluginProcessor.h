@@ -2,14 +2,19 @@
 
 #include <juce_audio_processors/juce_audio_processors.h>
 #include <juce_dsp/juce_dsp.h>
+#include <optional>
 #include "Sampler/OmniverseSampler.h"
 #include "Utils/Parameters.h"
-#include "DSP/BBDDelay.h"
-#include "DSP/BBDChorus.h"
-#include "DSP/TapeSaturation.h"
-#include "DSP/SpectralFilter.h"
+#include "Utils/CpuGovernor.h"
+#include "Utils/SnapshotMorph.h"
+#include "Utils/SpscFifo.h"
+#include "DSP/EffectChain.h"
+#include "DSP/ParameterRamp.h"
 
-class OmniverseAudioProcessor : public juce::AudioProcessor
+class OmniverseAudioProcessor : public juce::AudioProcessor,
+                                private juce::AudioProcessorValueTreeState::Listener,
+                                private juce::AsyncUpdater,
+                                private juce::Timer
 {
 public:
     OmniverseAudioProcessor();
@@ -41,27 +46,395 @@ public:
     void getStateInformation(juce::MemoryBlock& destData) override;
     void setStateInformation(const void* data, int sizeInBytes) override;
 
+    // Zones are stored the same way in the slot state and in bank definitions
+    static juce::ValueTree createZoneTree(const juce::String& filePath, const SampleSlot::ZoneMapping& mapping);
+    static SampleSlot::ZoneMapping readZoneMapping(const juce::ValueTree& zoneTree);
+
     juce::AudioProcessorValueTreeState& getAPVTS() { return apvts; }
     OmniverseSampler& getSampler() { return sampler; }
 
+    // .sfz files are imported as a multisample instrument
     bool loadSampleIntoSlot(int slotIndex, const juce::File& file);
 
+    // Adds a key/velocity zone to a slot (the first zone if the slot is empty)
+    bool addZoneToSlot(int slotIndex, const juce::File& file, const SampleSlot::ZoneMapping& mapping);
+
+    // === BANKS ===
+    // Named slot sets switched by MIDI program change. Warm banks are loaded
+    // in the background as soon as they are set; others load when their
+    // program change arrives and are dropped again once switched away from.
+    void setBank(int program, const SlotBank::Definition& definition);
+    void removeBank(int program);
+    void setBankWarm(int program, bool warm);
+
+    // Saves the active bank's slot files as a bank
+    void storeBank(int program, const juce::String& name, bool warm);
+
+    const std::map<int, SlotBank::Definition>& getBankDefinitions() const { return bankDefinitions; }
+
+    // Render load and the quality level it has forced (0 = full quality)
+    const CpuGovernor& getGovernor() const { return governor; }
+
+    // Bounces a slot's region through its filter/LFO on a background thread
+    void freezeSlot(int slotIndex);
+    void unfreezeSlot(int slotIndex);
+    bool isSlotFrozen(int slotIndex) const;
+
+    // === MORPH ===
+    // Stores the current parameter values as SnapshotMorph::A or B; the
+    // morph parameter then moves the engine between the two
+    void storeMorphSnapshot(int snapshot);
+    bool hasMorphSnapshot(int snapshot) const { return morph.hasSnapshot(snapshot); }
+
 private:
+    // Slot playback regions are rebuilt on the message thread when in/out or loop settings change
+    void parameterChanged(const juce::String& parameterID, float newValue) override;
+    void handleAsyncUpdate() override;
+    void addListenedParameter(const juce::String& parameterID);
+
+    // What a change to a listened slot parameter calls for
+    struct SlotUpdate
+    {
+        enum Kind { None, ModRouting, Region, Slices };
+
+        Kind kind = None;
+        int slotIndex = -1;
+    };
+
+    static SlotUpdate getSlotUpdate(const juce::String& parameterID);
+
+    // Any thread; true if the slot now needs updateDirtySlots()
+    bool markSlotDirty(const SlotUpdate& update);
+    void updateDirtySlots();
+    SampleSlot::RegionSettings getRegionSettings(int slotIndex);
+    void updateSlotRegion(int slotIndex);
+    void updateSlotSlices(int slotIndex);
+
+    // Reads the first ZONE_PRELOAD_SECONDS of every region now and queues the rest
+    bool loadSfzIntoSlot(int slotIndex, const juce::File& sfzFile);
+    static constexpr double ZONE_PRELOAD_SECONDS = 0.3;
+
+    // Bank loading runs on bankLoadPool; finished banks are installed on the
+    // message thread, and banks swapped out are freed from the timer once
+    // nothing can still reach them
+    void timerCallback() override;
+    void loadBank(int program, bool activate);
+    void loadBankSlot(SampleSlot& slot, int slotIndex, const SlotBank::Definition& definition, double sampleRate);
+    void installFinishedBanks();
+    void retireBank(int program, std::unique_ptr<SlotBank> bank);
+    void freeRetiredBanks();
+
+    // Slot data replaced while voices may be reading it (see Published) is
+    // stamped with the audio heartbeat and freed once a block has ended since
+    void collectRetiredSlotData(SlotBank& bank);
+    void freeRetiredSlotData();
+
+    // === ENGINE COMMANDS ===
+    // Structural edits (assigning and switching banks, retiring them,
+    // suspending a slot while its sample is replaced) are queued on the
+    // message thread and applied at the top of processBlock, so the audio
+    // thread never locks for them. Retired banks go back through
+    // retiredObjects once nothing plays from them and are freed here.
+    struct EngineCommand
+    {
+        enum class Type
+        {
+            AssignBank,
+            SelectBank,
+            RetireBank,
+            SuspendSlot,
+            ResumeSlot
+        };
+
+        Type type = Type::SelectBank;
+        int index = 0; // program or slot
+        SlotBank* bank = nullptr;
+
+        // RetireBank: owned by the audio thread from here on
+        std::unique_ptr<SlotBank> retiredBank;
+    };
+
+    struct RetiredObject
+    {
+        std::unique_ptr<SlotBank> bank;
+    };
+
+    static constexpr int MAX_ENGINE_COMMANDS = 1024;
+    static constexpr int COMMAND_TIMEOUT_MS = 500;
+
+    // Longer than any host block: a heartbeat this old means the host has
+    // stopped calling processBlock, whether or not it released resources
+    static constexpr juce::uint32 AUDIO_STALL_MS = 200;
+
+    // A retired bank still in use holds a voice, so no more than this can be waiting
+    static constexpr int MAX_RETIRING_BANKS = OmniverseSampler::NUM_VOICES + 1;
+
+    // Message thread. Retries while the queue is full and audio is running;
+    // false if the command couldn't be queued (it is left untouched).
+    bool sendEngineCommand(EngineCommand& command);
+
+    // Message thread: until everything sent so far is applied, or audio
+    // isn't running (the commands then apply before the next block's MIDI).
+    // False if audio is running but the commands weren't applied in time.
+    bool waitForEngineCommands();
+
+    // Message thread: processBlock has been called within AUDIO_STALL_MS, or
+    // is running now
+    bool isAudioRunning();
+
+    // Message thread: sends the ResumeSlot commands a ScopedSlotEdit couldn't
+    // queue, in order, stopping at the first that still can't be
+    void retryFailedResumes();
+
+    // Audio thread
+    void applyEngineCommands();
+    bool applyEngineCommand(EngineCommand& command);
+
+    // Suspends a slot of the active bank for as long as it lives, so its
+    // voices stop rather than carry on into the sample that replaces theirs.
+    // Only edit the slot if isSuspended(): the suspension may not have
+    // reached the audio thread.
+    class ScopedSlotEdit
+    {
+    public:
+        ScopedSlotEdit(OmniverseAudioProcessor& owner, int slotIndex);
+        ~ScopedSlotEdit();
+
+        bool isSuspended() const { return suspended; }
+        SampleSlot* getSlot() const { return slot; }
+
+    private:
+        OmniverseAudioProcessor& processor;
+        SlotBank* bank;
+        int index;
+        SampleSlot* slot;
+        bool sent = false;
+        bool suspended = false;
+
+        JUCE_DECLARE_NON_COPYABLE(ScopedSlotEdit)
+    };
+
+    // Message thread: a slot stays suspended until its resume is queued, so
+    // these are retried from the timer rather than dropped
+    std::vector<EngineCommand> failedResumes;
+
+    // === MICRO-BLOCKS ===
+    // The engine (sampler, effects, master) always runs on MICRO_BLOCK_SIZE
+    // samples, whatever the host block size, so parameter reads and other
+    // per-block work happen once per micro-block even for 1-sample host
+    // blocks. Each micro-block is rendered one block late, once all of its
+    // MIDI has arrived, which is reported as latency.
+    static constexpr int MICRO_BLOCK_SIZE = 32;
+    static constexpr size_t MIDI_RESERVE_BYTES = 4096;
+
+    void renderMicroBlock();
+
+    juce::AudioBuffer<float> microBlock;
+    int microBlockPosition = MICRO_BLOCK_SIZE; // next sample to hand to the host
+    juce::MidiBuffer pendingMidi;              // relative to the next micro-block
+    juce::MidiBuffer laterMidi;
+    juce::MidiBuffer microBlockMidi;
+
+    // === ENGINE PARAMETERS ===
+    // Everything the audio thread reads from the APVTS, looked up once in the
+    // constructor instead of by name every block
+    struct ParameterPointers
+    {
+        std::atomic<float>* masterVolume = nullptr;
+        std::atomic<float>* stereoWidth = nullptr;
+        std::atomic<float>* morph = nullptr;
+        std::atomic<float>* adaptiveQuality = nullptr;
+
+        std::atomic<float>* delayTime = nullptr;
+        std::atomic<float>* delayFeedback = nullptr;
+        std::atomic<float>* delayModDepth = nullptr;
+        std::atomic<float>* delayModRate = nullptr;
+        std::atomic<float>* delayTone = nullptr;
+        std::atomic<float>* delayMix = nullptr;
+        std::atomic<float>* delayBypass = nullptr;
+
+        std::atomic<float>* chorusRate = nullptr;
+        std::atomic<float>* chorusDepth = nullptr;
+        std::atomic<float>* chorusTone = nullptr;
+        std::atomic<float>* chorusMix = nullptr;
+        std::atomic<float>* chorusBypass = nullptr;
+
+        std::atomic<float>* tapeDrive = nullptr;
+        std::atomic<float>* tapeCompression = nullptr;
+        std::atomic<float>* tapeTone = nullptr;
+        std::atomic<float>* tapeMix = nullptr;
+        std::atomic<float>* tapeBypass = nullptr;
+
+        std::atomic<float>* spectralLow = nullptr;
+        std::atomic<float>* spectralMid = nullptr;
+        std::atomic<float>* spectralHigh = nullptr;
+        std::atomic<float>* spectralSpread = nullptr;
+        std::atomic<float>* spectralMix = nullptr;
+        std::atomic<float>* spectralBypass = nullptr;
+
+        std::atomic<float>* effectChain = nullptr;
+        std::atomic<float>* effectOrder = nullptr;
+        std::array<std::atomic<float>*, EffectChain::NumEffects> branchLevels {};
+    };
+
+    // Snapshots of the values last passed to each effect; setters are only
+    // called when one of them differs
+    struct DelaySettings
+    {
+        float time, feedback, modDepth, modRate, tone, mix;
+        bool operator==(const DelaySettings&) const = default;
+    };
+
+    struct ChorusSettings
+    {
+        float rate, depth, tone, mix;
+        bool operator==(const ChorusSettings&) const = default;
+    };
+
+    struct TapeSettings
+    {
+        float drive, compression, tone, mix;
+        bool operator==(const TapeSettings&) const = default;
+    };
+
+    struct SpectralSettings
+    {
+        float low, mid, high, spread, mix;
+        bool operator==(const SpectralSettings&) const = default;
+    };
+
+    struct ChainSettings
+    {
+        int chain, order;
+        std::array<float, EffectChain::NumEffects> branchLevels;
+        bool operator==(const ChainSettings&) const = default;
+    };
+
+    void resolveParameterPointers();
+    void updateEffectBypass();
     void updateDelayParameters();
     void updateChorusParameters();
     void updateTapeParameters();
     void updateSpectralParameters();
+    void updateChainTopology();
+
+    static bool isOn(const std::atomic<float>* parameter)
+    {
+        return parameter->load(std::memory_order_relaxed) > 0.5f;
+    }
 
     juce::AudioProcessorValueTreeState apvts;
     OmniverseSampler sampler;
 
-    // Global effects
-    BBDDelay bbdDelay;
-    BBDChorus bbdChorus;
-    TapeSaturation tapeSaturation;
-    SpectralFilter spectralFilter;
+    ParameterPointers params;
+    std::optional<DelaySettings> lastDelaySettings;
+    std::optional<ChorusSettings> lastChorusSettings;
+    std::optional<TapeSettings> lastTapeSettings;
+    std::optional<SpectralSettings> lastSpectralSettings;
+    std::optional<ChainSettings> lastChainSettings;
+
+    // Master volume (dB as last converted) and stereo width glide per
+    // sample; ramps are applied with vector ops, mid/side via the scratch
+    float lastMasterVolumeDb = 0.0f;
+    ParameterRamp masterGainRamp { ParameterRamp::Shape::Multiplicative, 1.0f };
+    ParameterRamp stereoWidthRamp { ParameterRamp::Shape::Linear, 1.0f };
+    juce::AudioBuffer<float> midSideScratch;
+
+    // === MORPH ===
+    // Every parameter but the morph itself and adaptive quality takes part.
+    // Morphed values are written straight into the raw values the engine
+    // reads, so nothing goes to the host and the editor keeps showing what
+    // was set; parameters the processor listens to also mark their slot
+    // dirty, for the timer to act on. Applied once per micro-block.
+    struct MorphTarget
+    {
+        juce::RangedAudioParameter* parameter = nullptr;
+        std::atomic<float>* value = nullptr;
+        SlotUpdate update;
+    };
+
+    void setupMorph();
+    void applyMorph();
+
+    juce::StringArray listenedParameterIDs;
+    std::vector<MorphTarget> morphTargets;
+    SnapshotMorph morph;
+
+    // Global effects, in the order and topology of the chain parameters
+    EffectChain effectChain;
 
     juce::AudioFormatManager formatManager;
 
+    // Lowers sampler quality when processBlock overruns its budget; level
+    // changes are logged from the timer
+    CpuGovernor governor;
+    void logGovernorEvents();
+
+    // Slots whose playback region needs rebuilding
+    std::atomic<Parameters::SlotMask> regionDirty { 0 };
+
+    // Slots whose slice mode changed
+    std::atomic<Parameters::SlotMask> sliceDirty { 0 };
+
+    // Message thread only, except finishedBanks
+    std::map<int, SlotBank::Definition> bankDefinitions;
+    std::map<int, std::unique_ptr<SlotBank>> loadedBanks;
+    std::map<int, int> bankLoadSerials;
+    int nextBankLoadSerial = 0;
+    SlotBank* lastActiveBank = nullptr;
+
+    struct FinishedBank
+    {
+        int program = 0;
+        int serial = 0;
+        bool activate = false;
+        std::unique_ptr<SlotBank> bank;
+    };
+
+    juce::CriticalSection finishedBanksLock;
+    std::vector<FinishedBank> finishedBanks;
+
+    // Banks handed back by the audio thread; background jobs hold raw slot
+    // pointers, so they are freed once those are done too
+    std::vector<std::unique_ptr<SlotBank>> retiredBanks;
+    static constexpr int BANK_TIMER_MS = 250;
+
+    struct RetiredSlotData
+    {
+        std::uint64_t epoch = 0;
+        SampleSlot::RetiredData data;
+    };
+
+    std::vector<RetiredSlotData> retiredSlotData;
+
+    SpscFifo<EngineCommand, MAX_ENGINE_COMMANDS> engineCommands;
+    SpscFifo<RetiredObject, MAX_RETIRING_BANKS> retiredObjects;
+    std::uint64_t engineCommandsSent = 0;
+    std::atomic<std::uint64_t> engineCommandsApplied { 0 };
+    std::atomic<bool> engineRunning { false };
+
+    // Heartbeat: bumped on entering and on leaving processBlock, so it is odd
+    // while a block runs. The message thread notes when it last moved.
+    std::atomic<std::uint64_t> audioEpoch { 0 };
+    std::uint64_t lastSeenAudioEpoch = 0;
+    juce::uint32 lastAudioEpochChangeMs = 0;
+
+    // Audio thread: retired banks still active or playing, and a command
+    // waiting for room among them
+    std::array<std::unique_ptr<SlotBank>, MAX_RETIRING_BANKS> retiringBanks;
+    EngineCommand deferredCommand;
+    bool hasDeferredCommand = false;
+
+    // Retired while the queue stayed full; kept until shutdown since the
+    // audio thread may still know them
+    std::vector<std::unique_ptr<SlotBank>> undeliveredBanks;
+
+    // Run slot freeze renders and transient slicing, fill in lazily loaded
+    // zones and load banks; declared last so they are destroyed (and their
+    // jobs finished) before the slots they use
+    juce::ThreadPool freezePool { 1 };
+    juce::ThreadPool zoneLoadPool { 1 };
+    juce::ThreadPool bankLoadPool { 1 };
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(OmniverseAudioProcessor)
 };
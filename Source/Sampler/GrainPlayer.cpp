@@ -0,0 +1,173 @@
+#include "GrainPlayer.h"
+#include "SampleSlot.h"
+
+const std::array<float, GrainPlayer::WINDOW_SIZE + 1>& GrainPlayer::getWindowTable()
+{
+    // Hann window, built once; the extra point lets the last lookup stay in range
+    static const auto table = []
+    {
+        std::array<float, WINDOW_SIZE + 1> t {};
+        for (int i = 0; i <= WINDOW_SIZE; ++i)
+        {
+            float phase = static_cast<float>(i) / static_cast<float>(WINDOW_SIZE);
+            t[static_cast<size_t>(i)] = 0.5f - 0.5f * std::cos(juce::MathConstants<float>::twoPi * phase);
+        }
+        return t;
+    }();
+
+    return table;
+}
+
+void GrainPlayer::prepare(double newSampleRate)
+{
+    sampleRate = newSampleRate;
+
+    // Build the shared window table here rather than on the audio thread
+    getWindowTable();
+
+    reset();
+}
+
+void GrainPlayer::reset()
+{
+    for (auto& grain : grains)
+        grain.active = false;
+
+    numActiveGrains = 0;
+    scanPosition = 0.0;
+    spawnCountdown = 0.0;
+}
+
+void GrainPlayer::setParameters(float grainSizeMs, float densityHz, float newScanRate)
+{
+    grainLength = std::max(static_cast<int>((grainSizeMs / 1000.0f) * sampleRate), 16);
+    spawnInterval = sampleRate / std::max(densityHz, 0.1f);
+    scanRate = newScanRate;
+
+    // Roughly constant loudness regardless of how many grains overlap
+    float overlap = static_cast<float>(grainLength / spawnInterval);
+    grainGain = 1.0f / std::sqrt(std::max(overlap, 1.0f));
+}
+
+void GrainPlayer::spawnGrain(const Source& source, double position, float pitchRatio, int startOffset)
+{
+    for (auto& grain : grains)
+    {
+        if (grain.active)
+            continue;
+
+        // Small position jitter (10% of a grain) avoids comb-like repetition
+        double jitter = (random.nextDouble() - 0.5) * 0.1 * grainLength;
+
+        grain.position = std::clamp(position + jitter, 0.0, static_cast<double>(source.length - 1));
+        grain.ratio = pitchRatio;
+        grain.windowPhase = 0.0f;
+        grain.windowStep = static_cast<float>(WINDOW_SIZE) / static_cast<float>(grainLength);
+        grain.startOffset = startOffset;
+        grain.active = true;
+        ++numActiveGrains;
+        return;
+    }
+
+    // Pool exhausted: the grain is dropped rather than allocated
+}
+
+bool GrainPlayer::render(const Source& source, float pitchRatio, float* outL, float* outR, int numSamples)
+{
+    if (source.length <= 0)
+        return false;
+
+    const double length = static_cast<double>(source.length);
+    bool scanInRange = scanPosition < length;
+
+    // === SPAWN ===
+    // Grains due within this block start at their exact offset
+    if (scanInRange)
+    {
+        while (spawnCountdown < numSamples)
+        {
+            int offset = std::max(static_cast<int>(spawnCountdown), 0);
+            spawnGrain(source, scanPosition + scanRate * offset, pitchRatio, offset);
+            spawnCountdown += spawnInterval;
+        }
+    }
+    spawnCountdown -= numSamples;
+
+    // === SCAN ===
+    // The scan head moves independently of grain pitch
+    scanPosition += scanRate * numSamples;
+    if (source.loop && scanPosition >= length)
+        scanPosition = std::fmod(scanPosition, length);
+
+    // === GRAINS ===
+    // Grain-outer. How far each grain runs in this block is known up front,
+    // so its reads are gathered into scratch with no per-sample end test and
+    // the window and mix run as vector operations.
+    for (auto& grain : grains)
+    {
+        if (!grain.active)
+            continue;
+
+        int remaining = static_cast<int>(std::ceil((static_cast<float>(WINDOW_SIZE) - grain.windowPhase) / grain.windowStep));
+        int count = std::max(std::min(numSamples - grain.startOffset, remaining), 0);
+
+        for (int offset = 0; offset < count; offset += SCRATCH_SIZE)
+        {
+            int n = std::min(count - offset, SCRATCH_SIZE);
+            int first = grain.startOffset + offset;
+
+            gatherGrain(source, grain, offset, n);
+
+            juce::FloatVectorOperations::multiply(windowGains.data(), grainGain, n);
+            juce::FloatVectorOperations::addWithMultiply(outL + first, scratchL.data(), windowGains.data(), n);
+            juce::FloatVectorOperations::addWithMultiply(outR + first, scratchR.data(), windowGains.data(), n);
+        }
+
+        grain.position += static_cast<double>(grain.ratio) * count;
+        grain.windowPhase += grain.windowStep * static_cast<float>(count);
+        grain.startOffset = 0;
+
+        if (count >= remaining)
+        {
+            grain.active = false;
+            --numActiveGrains;
+        }
+    }
+
+    return scanInRange || numActiveGrains > 0;
+}
+
+void GrainPlayer::gatherGrain(const Source& source, const Grain& grain, int offset, int numSamples)
+{
+    // Interpolated frames and window values for samples [offset, offset +
+    // numSamples) of the grain's run. Positions and phases are computed from
+    // the grain's start rather than accumulated, so the loop carries nothing
+    // from one sample to the next.
+    const auto& window = getWindowTable();
+    const double length = static_cast<double>(source.length);
+
+    for (int i = 0; i < numSamples; ++i)
+    {
+        double position = grain.position + static_cast<double>(grain.ratio) * (offset + i);
+        if (position >= length)
+            position = source.loop ? std::fmod(position, length) : length - 1.0;
+
+        int index0 = static_cast<int>(position);
+        float frac = static_cast<float>(position - index0);
+
+        float phase = grain.windowPhase + grain.windowStep * static_cast<float>(offset + i);
+        windowGains[static_cast<size_t>(i)] = window[static_cast<size_t>(std::min(static_cast<int>(phase), WINDOW_SIZE))];
+
+       #if OMNIVERSE_INTERLEAVED_SAMPLES
+        const float* frame0 = source.frames + 2 * (source.baseFrame + source.frameStep * index0);
+        const float* frame1 = frame0 + 2 * source.frameStep;
+        scratchL[static_cast<size_t>(i)] = frame0[0] + frac * (frame1[0] - frame0[0]);
+        scratchR[static_cast<size_t>(i)] = frame0[1] + frac * (frame1[1] - frame0[1]);
+       #else
+        int pos0 = std::clamp(source.baseFrame + source.frameStep * index0, 0, source.lastFrame);
+        int pos1 = std::clamp(pos0 + source.frameStep, 0, source.lastFrame);
+        scratchL[static_cast<size_t>(i)] = source.dataL[pos0] + frac * (source.dataL[pos1] - source.dataL[pos0]);
+        scratchR[static_cast<size_t>(i)] = source.dataR[pos0] + frac * (source.dataR[pos1] - source.dataR[pos0]);
+       #endif
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <juce_audio_basics/juce_audio_basics.h>
+
+// Granular playback for one slot of one voice. Grains come from a fixed pool
+// so note-on and grain spawns never allocate; the window is a shared table.
+class GrainPlayer
+{
+public:
+    static constexpr int MAX_GRAINS = 32;
+
+    // Where grains read from: playback-order positions map to buffer frames
+    // as baseFrame + frameStep * position (frameStep is -1 in reverse).
+    struct Source
+    {
+        const float* dataL = nullptr;
+        const float* dataR = nullptr;
+        const float* frames = nullptr; // interleaved frame 0 (see SampleSlot::InterleavedBuffer)
+        int baseFrame = 0;
+        int frameStep = 1;
+        int lastFrame = 0;
+        int length = 0;
+        bool loop = false;
+    };
+
+    GrainPlayer() = default;
+
+    void prepare(double sampleRate);
+    void reset();
+    void setParameters(float grainSizeMs, float densityHz, float scanRate);
+
+    // Adds numSamples frames of grains to outL/outR. Returns false once the
+    // scan head has left the region and the last grain has finished.
+    bool render(const Source& source, float pitchRatio, float* outL, float* outR, int numSamples);
+
+    int getNumActiveGrains() const { return numActiveGrains; }
+
+private:
+    struct Grain
+    {
+        double position = 0.0;
+        float ratio = 1.0f;
+        float windowPhase = 0.0f;
+        float windowStep = 0.0f;
+        int startOffset = 0;
+        bool active = false;
+    };
+
+    void spawnGrain(const Source& source, double position, float pitchRatio, int startOffset);
+    void gatherGrain(const Source& source, const Grain& grain, int offset, int numSamples);
+
+    static constexpr int WINDOW_SIZE = 1024;
+    static const std::array<float, WINDOW_SIZE + 1>& getWindowTable();
+
+    std::array<Grain, MAX_GRAINS> grains;
+    int numActiveGrains = 0;
+
+    // One grain's gathered frames and window gains, mixed in with vector ops
+    static constexpr int SCRATCH_SIZE = 64;
+    std::array<float, SCRATCH_SIZE> scratchL {};
+    std::array<float, SCRATCH_SIZE> scratchR {};
+    std::array<float, SCRATCH_SIZE> windowGains {};
+
+    double sampleRate = 44100.0;
+    double scanPosition = 0.0;
+    double spawnCountdown = 0.0;
+
+    // Derived from parameters
+    int grainLength = 3528;
+    double spawnInterval = 2205.0;
+    float scanRate = 1.0f;
+    float grainGain = 1.0f;
+
+    juce::Random random;
+};
@@ -3,72 +3,291 @@
 
 OmniverseSampler::OmniverseSampler()
 {
-    for (int i = 0; i < NUM_SLOTS; ++i)
-    {
-        slotPointers[i] = &slots[i];
-    }
-
     addSound(new OmniverseSound());
 
     for (int i = 0; i < NUM_VOICES; ++i)
     {
-        auto* voice = new OmniverseVoice();
-        voice->setSlots(&slotPointers);
-        addVoice(voice);
+        addVoice(new OmniverseVoice());
     }
 }
 
 void OmniverseSampler::setAPVTS(juce::AudioProcessorValueTreeState* apvtsPtr)
 {
     apvts = apvtsPtr;
+    voiceParameters.resolve(*apvts);
 
     for (int i = 0; i < getNumVoices(); ++i)
     {
         if (auto* voice = dynamic_cast<OmniverseVoice*>(getVoice(i)))
         {
-            voice->setAPVTS(apvts);
+            voice->setParameters(&voiceParameters);
+        }
+    }
+
+    for (int i = 0; i < NUM_SLOTS; ++i)
+    {
+        auto& slotParameters = modParameters[static_cast<size_t>(i)];
+        slotParameters.lfoDepth = apvts->getRawParameterValue(Parameters::slotLfoDepth(i));
+
+        for (int row = 0; row < Parameters::MOD_ROWS; ++row)
+        {
+            auto& rowParameters = slotParameters.rows[static_cast<size_t>(row)];
+            rowParameters.source = apvts->getRawParameterValue(Parameters::slotModSource(i, row));
+            rowParameters.destination = apvts->getRawParameterValue(Parameters::slotModDestination(i, row));
+            rowParameters.amount = apvts->getRawParameterValue(Parameters::slotModAmount(i, row));
+        }
+    }
+
+    modRoutingDirty.store(Parameters::ALL_SLOTS);
+}
+
+void OmniverseSampler::invalidateModRouting(int slotIndex)
+{
+    if (slotIndex >= 0 && slotIndex < NUM_SLOTS)
+        modRoutingDirty.fetch_or(Parameters::slotBit(slotIndex));
+}
+
+void OmniverseSampler::compileModRouting()
+{
+    if (apvts == nullptr)
+        return;
+
+    for (auto dirty = modRoutingDirty.exchange(0); dirty != 0; dirty &= dirty - 1)
+    {
+        int slotIndex = std::countr_zero(dirty);
+        const auto& slotParameters = modParameters[static_cast<size_t>(slotIndex)];
+        auto& matrix = modMatrices[static_cast<size_t>(slotIndex)];
+
+        matrix.clear();
+
+        // The LFO section's depth is a fixed LFO -> cutoff row
+        matrix.add(ModMatrix::Lfo, ModMatrix::Cutoff, slotParameters.lfoDepth->load());
+
+        for (const auto& row : slotParameters.rows)
+        {
+            // Source choice 0 is "Off"
+            int source = juce::roundToInt(row.source->load()) - 1;
+            matrix.add(source, juce::roundToInt(row.destination->load()), row.amount->load());
         }
     }
 }
 
 SampleSlot* OmniverseSampler::getSlot(int index)
 {
-    if (index >= 0 && index < NUM_SLOTS)
-        return &slots[index];
-    return nullptr;
+    return getActiveBank().getSlot(index);
 }
 
 const SampleSlot* OmniverseSampler::getSlot(int index) const
 {
-    if (index >= 0 && index < NUM_SLOTS)
-        return &slots[index];
-    return nullptr;
+    return activeBank.load(std::memory_order_acquire)->getSlot(index);
 }
 
-std::vector<int> OmniverseSampler::determineActiveSlots()
+void OmniverseSampler::selectBank(SlotBank* bank)
 {
-    if (apvts == nullptr)
+    if (bank != nullptr)
+        activeBank.store(bank, std::memory_order_release);
+}
+
+void OmniverseSampler::setProgramBank(int program, SlotBank* bank)
+{
+    if (program >= 0 && program < static_cast<int>(programBanks.size()))
+        programBanks[static_cast<size_t>(program)] = bank;
+}
+
+void OmniverseSampler::unassignProgramBank(int program, const SlotBank* bank)
+{
+    if (program >= 0 && program < static_cast<int>(programBanks.size())
+        && programBanks[static_cast<size_t>(program)] == bank)
+        programBanks[static_cast<size_t>(program)] = nullptr;
+}
+
+void OmniverseSampler::suspendSlot(SlotBank* bank, int slotIndex)
+{
+    if (bank == nullptr || slotIndex < 0 || slotIndex >= NUM_SLOTS)
+        return;
+
+    if (bank != suspendedBank)
+        suspendedSlots = 0;
+
+    suspendedBank = bank;
+    suspendedSlots |= Parameters::slotBit(slotIndex);
+
+    // No tail: the audio is about to change under it
+    for (auto* voice : voices)
     {
-        std::vector<int> all;
-        for (int i = 0; i < NUM_SLOTS; ++i)
-            all.push_back(i);
-        return all;
+        if (auto* omniverseVoice = dynamic_cast<OmniverseVoice*>(voice);
+            omniverseVoice != nullptr && omniverseVoice->isPlayingSlot(bank, slotIndex))
+            omniverseVoice->stopNote(0.0f, false);
     }
+}
 
-    bool layerMode = apvts->getRawParameterValue(Parameters::PLAYBACK_LAYER)->load() > 0.5f;
-    bool randomMode = apvts->getRawParameterValue(Parameters::PLAYBACK_RANDOM)->load() > 0.5f;
+void OmniverseSampler::resumeSlot(SlotBank* bank, int slotIndex)
+{
+    if (bank == suspendedBank && slotIndex >= 0 && slotIndex < NUM_SLOTS)
+        suspendedSlots &= ~Parameters::slotBit(slotIndex);
+}
+
+bool OmniverseSampler::isBankInUse(const SlotBank* bank) const
+{
+    return activeBank.load(std::memory_order_acquire) == bank || bank->hasVoices();
+}
+
+void OmniverseSampler::handleController(int midiChannel, int controllerNumber, int controllerValue)
+{
+    // Every voice keeps the wheel position, so notes started later see it too
+    if (controllerNumber == 1)
+    {
+        for (auto* voice : voices)
+        {
+            if (auto* omniverseVoice = dynamic_cast<OmniverseVoice*>(voice))
+                omniverseVoice->setModWheel(static_cast<float>(controllerValue) / 127.0f);
+        }
+    }
+
+    Synthesiser::handleController(midiChannel, controllerNumber, controllerValue);
+}
+
+void OmniverseSampler::handleProgramChange(int /*midiChannel*/, int programNumber)
+{
+    if (programNumber < 0 || programNumber >= static_cast<int>(programBanks.size()))
+        return;
+
+    // Unloaded banks can't be read here; ask for one and keep playing the current bank
+    if (auto* bank = programBanks[static_cast<size_t>(programNumber)])
+        activeBank.store(bank, std::memory_order_release);
+    else
+        requestedProgram.store(programNumber);
+}
+
+void OmniverseSampler::setQualityLevel(int level)
+{
+    if (level == qualityLevel)
+        return;
+
+    qualityLevel = level;
+    voiceLimit = level >= 3 ? NUM_VOICES / 2 : NUM_VOICES;
 
-    // Find which slots have samples loaded
-    std::vector<int> loadedSlots;
+    bool interpolate = level < 1;
+    int controlRate = level >= 2 ? OmniverseVoice::MAX_CONTROL_RATE_DIVIDER : OmniverseVoice::CONTROL_RATE_DIVIDER;
+    int unisonLanes = level >= 4 ? 1 : OmniverseVoice::MAX_UNISON;
+
+    for (auto* voice : voices)
+    {
+        if (auto* omniverseVoice = dynamic_cast<OmniverseVoice*>(voice))
+            omniverseVoice->setQuality(interpolate, controlRate, unisonLanes);
+    }
+}
+
+juce::String OmniverseSampler::getQualityLevelName(int level)
+{
+    switch (level)
+    {
+        case 0: return "full quality";
+        case 1: return "no sample interpolation";
+        case 2: return "halved control rate";
+        case 3: return "voice limit " + juce::String(NUM_VOICES / 2);
+        default: return "no unison";
+    }
+}
+
+// Once voiceLimit voices are busy, the one a new slot should take over:
+// the oldest released voice, else the oldest one
+juce::SynthesiserVoice* OmniverseSampler::findVoiceOverLimit() const
+{
+    int active = 0;
+    juce::SynthesiserVoice* oldest = nullptr;
+    juce::SynthesiserVoice* oldestReleased = nullptr;
+
+    for (auto* voice : voices)
+    {
+        if (!voice->isVoiceActive())
+            continue;
+
+        ++active;
+
+        if (isStartedByCurrentNote(voice))
+            continue;
+
+        if (oldest == nullptr || voice->wasStartedBefore(*oldest))
+            oldest = voice;
+
+        if (voice->isPlayingButReleased() && (oldestReleased == nullptr || voice->wasStartedBefore(*oldestReleased)))
+            oldestReleased = voice;
+    }
+
+    if (active < voiceLimit)
+        return nullptr;
+
+    return oldestReleased != nullptr ? oldestReleased : oldest;
+}
+
+juce::SynthesiserVoice* OmniverseSampler::findVoiceToSteal(juce::SynthesiserSound* /*soundToPlay*/,
+                                                           int /*midiChannel*/, int /*midiNoteNumber*/) const
+{
+    juce::SynthesiserVoice* oldest = nullptr;
+    juce::SynthesiserVoice* oldestReleased = nullptr;
+
+    for (auto* voice : voices)
+    {
+        if (isStartedByCurrentNote(voice))
+            continue;
+
+        if (oldest == nullptr || voice->wasStartedBefore(*oldest))
+            oldest = voice;
+
+        if (voice->isPlayingButReleased() && (oldestReleased == nullptr || voice->wasStartedBefore(*oldestReleased)))
+            oldestReleased = voice;
+    }
+
+    return oldestReleased != nullptr ? oldestReleased : oldest;
+}
+
+bool OmniverseSampler::isStartedByCurrentNote(const juce::SynthesiserVoice* voice) const
+{
+    for (int i = 0; i < numCurrentNoteVoices; ++i)
+        if (currentNoteVoices[static_cast<size_t>(i)] == voice)
+            return true;
+
+    return false;
+}
+
+Parameters::SlotMask OmniverseSampler::getLoadedSlots(const SlotBank& bank)
+{
+    Parameters::SlotMask loaded = 0;
     for (int i = 0; i < NUM_SLOTS; ++i)
     {
-        if (slots[i].isLoaded())
-            loadedSlots.push_back(i);
+        if (bank.getSlot(i)->isLoaded())
+            loaded |= Parameters::slotBit(i);
     }
+    return loaded;
+}
+
+// Index of the nth set bit of mask (n < popcount(mask))
+static int nthSlot(Parameters::SlotMask mask, int n)
+{
+    for (; n > 0; --n)
+        mask &= mask - 1;
+    return std::countr_zero(mask);
+}
+
+Parameters::SlotMask OmniverseSampler::determineActiveSlots(const SlotBank& bank)
+{
+    if (apvts == nullptr)
+        return Parameters::ALL_SLOTS;
+
+    bool layerMode = apvts->getRawParameterValue(Parameters::PLAYBACK_LAYER)->load() > 0.5f;
+    bool randomMode = apvts->getRawParameterValue(Parameters::PLAYBACK_RANDOM)->load() > 0.5f;
 
-    if (loadedSlots.empty())
+    // Find which slots have samples loaded, leaving out any being edited
+    auto loadedSlots = getLoadedSlots(bank);
+    if (&bank == suspendedBank)
+        loadedSlots &= ~suspendedSlots;
+
+    if (loadedSlots == 0)
         return loadedSlots;
 
+    int numLoaded = std::popcount(loadedSlots);
+
     if (layerMode && !randomMode)
     {
         // Layer mode: play all loaded slots
@@ -77,14 +296,13 @@ std::vector<int> OmniverseSampler::determineActiveSlots()
     else if (randomMode)
     {
         // Random mode: pick one random slot
-        int randomIdx = random.nextInt(static_cast<int>(loadedSlots.size()));
-        return { loadedSlots[randomIdx] };
+        return Parameters::slotBit(nthSlot(loadedSlots, random.nextInt(numLoaded)));
     }
     else
     {
         // Round robin mode
-        roundRobinIndex = (roundRobinIndex + 1) % static_cast<int>(loadedSlots.size());
-        return { loadedSlots[roundRobinIndex] };
+        roundRobinIndex = (roundRobinIndex + 1) % numLoaded;
+        return Parameters::slotBit(nthSlot(loadedSlots, roundRobinIndex));
     }
 }
 
@@ -110,32 +328,50 @@ int OmniverseSampler::getOctaveShift()
 
 void OmniverseSampler::noteOn(int midiChannel, int midiNoteNumber, float velocity)
 {
-    auto activeSlots = determineActiveSlots();
+    // Every voice of the note plays from the same bank
+    auto* bank = activeBank.load(std::memory_order_acquire);
+    auto activeSlots = determineActiveSlots(*bank);
 
-    if (activeSlots.empty())
+    if (activeSlots == 0)
         return;
 
     int octaveShift = getOctaveShift();
     bool reverse = apvts != nullptr &&
                    apvts->getRawParameterValue(Parameters::REVERSE)->load() > 0.5f;
 
-    // Find a free voice
+    // Each slot of the note starts its own voice, and none of them may be
+    // stolen for a later slot of the same note
+    numCurrentNoteVoices = 0;
+
     for (auto* sound : sounds)
     {
         if (sound->appliesToNote(midiNoteNumber) && sound->appliesToChannel(midiChannel))
         {
-            auto* voice = findFreeVoice(sound, midiChannel, midiNoteNumber, true);
-
-            if (auto* omniverseVoice = dynamic_cast<OmniverseVoice*>(voice))
+            for (auto remaining = activeSlots; remaining != 0; remaining &= remaining - 1)
             {
-                omniverseVoice->setActiveSlots(activeSlots);
-                omniverseVoice->setReverse(reverse);
-                omniverseVoice->setOctaveShift(octaveShift);
+                int slotIndex = std::countr_zero(remaining);
+                // Under the governor's voice limit, new slots take over old voices
+                auto* voice = findVoiceOverLimit();
+                if (voice == nullptr)
+                    voice = findFreeVoice(sound, midiChannel, midiNoteNumber, true);
+
+                if (auto* omniverseVoice = dynamic_cast<OmniverseVoice*>(voice))
+                {
+                    omniverseVoice->setSlot(slotIndex, bank);
+                    omniverseVoice->setModMatrix(&modMatrices[static_cast<size_t>(slotIndex)]);
+                    omniverseVoice->setReverse(reverse);
+                    omniverseVoice->setOctaveShift(octaveShift);
+                    omniverseVoice->setGlideSourceNote(lastNoteNumber);
 
-                startVoice(voice, sound, midiChannel, midiNoteNumber, velocity);
+                    startVoice(voice, sound, midiChannel, midiNoteNumber, velocity);
+                    currentNoteVoices[static_cast<size_t>(numCurrentNoteVoices++)] = voice;
+                }
             }
 
+            lastNoteNumber = midiNoteNumber + (octaveShift * 12);
             break;
         }
     }
+
+    numCurrentNoteVoices = 0;
 }
@@ -3,7 +3,9 @@
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_processors/juce_audio_processors.h>
 #include "SampleSlot.h"
+#include "SlotBank.h"
 #include "OmniverseVoice.h"
+#include "../Utils/Parameters.h"
 
 class OmniverseSound : public juce::SynthesiserSound
 {
@@ -15,27 +17,126 @@ public:
 class OmniverseSampler : public juce::Synthesiser
 {
 public:
-    static constexpr int NUM_SLOTS = 5;
-    static constexpr int NUM_VOICES = 16;
+    static constexpr int NUM_SLOTS = Parameters::NUM_SLOTS;
+
+    // Voices are per slot: a layered note takes one voice for each slot it
+    // plays, and each frees itself when its slot finishes. The pool grows with
+    // the slot count so fully layered chords still fit.
+    static constexpr int NUM_VOICES = std::max(64, NUM_SLOTS * 8);
 
     OmniverseSampler();
 
     void setAPVTS(juce::AudioProcessorValueTreeState* apvtsPtr);
 
+    // Slots of the active bank
     SampleSlot* getSlot(int index);
     const SampleSlot* getSlot(int index) const;
 
+    // === BANKS ===
+    // Notes start from the active bank, initially the built-in one. A program
+    // change makes the bank assigned to that program active with a single
+    // pointer swap; voices already playing keep their own bank. The active
+    // bank can be read from any thread; everything else here is changed on
+    // the audio thread only, from the processor's command queue.
+    SlotBank& getActiveBank() { return *activeBank.load(std::memory_order_acquire); }
+    SlotBank& getDefaultBank() { return defaultBank; }
+    void selectBank(SlotBank* bank);
+
+    // Null unassigns the program
+    void setProgramBank(int program, SlotBank* bank);
+
+    // Unassigns the program only if it still has this bank
+    void unassignProgramBank(int program, const SlotBank* bank);
+
+    // Program changes that found no bank loaded, for the owner to load (-1 = none)
+    int takeRequestedProgram() { return requestedProgram.exchange(-1); }
+
+    // True while the bank is active or voices are still playing from it
+    bool isBankInUse(const SlotBank* bank) const;
+
+    // === SLOT EDITS ===
+    // While a slot is suspended (so its sample can be replaced or cleared)
+    // its voices are cut and no note starts on it. One slot edit at a time.
+    // Audio thread.
+    void suspendSlot(SlotBank* bank, int slotIndex);
+    void resumeSlot(SlotBank* bank, int slotIndex);
+
+    // === QUALITY ===
+    // Levels from CpuGovernor, each giving up more than the last: sample
+    // interpolation, then control rate, then half the voice pool, then unison.
+    // Audio thread.
+    void setQualityLevel(int level);
+    static juce::String getQualityLevelName(int level);
+
+    // === MODULATION ===
+    // Each slot's mod matrix rows (and LFO depth) are compiled into a flat
+    // routing list on the audio thread, before rendering, whenever they change.
+    // Any thread.
+    void invalidateModRouting(int slotIndex);
+
+    // Audio thread, before renderNextBlock
+    void compileModRouting();
+
     void noteOn(int midiChannel, int midiNoteNumber, float velocity) override;
+    void handleController(int midiChannel, int controllerNumber, int controllerValue) override;
+    void handleProgramChange(int midiChannel, int programNumber) override;
 
 private:
-    std::vector<int> determineActiveSlots();
+    static Parameters::SlotMask getLoadedSlots(const SlotBank& bank);
+    Parameters::SlotMask determineActiveSlots(const SlotBank& bank);
     int getOctaveShift();
+    juce::SynthesiserVoice* findVoiceOverLimit() const;
+    bool isStartedByCurrentNote(const juce::SynthesiserVoice* voice) const;
 
-    std::array<SampleSlot, NUM_SLOTS> slots;
-    std::array<SampleSlot*, NUM_SLOTS> slotPointers;
+protected:
+    // Steals the oldest released voice, else the oldest, never one this
+    // note-on has just started for another of its slots
+    juce::SynthesiserVoice* findVoiceToSteal(juce::SynthesiserSound* soundToPlay, int midiChannel,
+                                             int midiNoteNumber) const override;
+
+private:
+
+    SlotBank defaultBank;
+    std::atomic<SlotBank*> activeBank { &defaultBank };
+    std::array<SlotBank*, 128> programBanks {};
+    std::atomic<int> requestedProgram { -1 };
+
+    const SlotBank* suspendedBank = nullptr;
+    Parameters::SlotMask suspendedSlots = 0;
 
     juce::AudioProcessorValueTreeState* apvts = nullptr;
     juce::Random random;
 
+    // Routing parameters, resolved in setAPVTS so compiling doesn't look them up
+    struct ModRowParameters
+    {
+        std::atomic<float>* source = nullptr;
+        std::atomic<float>* destination = nullptr;
+        std::atomic<float>* amount = nullptr;
+    };
+
+    struct SlotModParameters
+    {
+        std::atomic<float>* lfoDepth = nullptr;
+        std::array<ModRowParameters, Parameters::MOD_ROWS> rows {};
+    };
+
+    std::array<SlotModParameters, NUM_SLOTS> modParameters {};
+
+    // Shared by every voice
+    OmniverseVoice::VoiceParameters voiceParameters;
+    std::array<ModMatrix, NUM_SLOTS> modMatrices;
+    std::atomic<Parameters::SlotMask> modRoutingDirty { Parameters::ALL_SLOTS };
+
+    // Voices started so far by the note-on in progress, one per slot
+    std::array<const juce::SynthesiserVoice*, NUM_SLOTS> currentNoteVoices {};
+    int numCurrentNoteVoices = 0;
+
     int roundRobinIndex = 0;
+
+    int qualityLevel = 0;
+    int voiceLimit = NUM_VOICES;
+
+    // Last triggered note, used as the glide source for the next note
+    int lastNoteNumber = -1;
 };
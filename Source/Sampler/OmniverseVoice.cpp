@@ -1,23 +1,61 @@
 #include "OmniverseVoice.h"
 #include "../Utils/Parameters.h"
+#include "../DSP/FastMath.h"
+#include "../Utils/Prefetch.h"
+
+void OmniverseVoice::VoiceParameters::resolve(juce::AudioProcessorValueTreeState& apvts)
+{
+    auto get = [&apvts](const juce::String& id)
+    {
+        auto* parameter = apvts.getRawParameterValue(id);
+        jassert(parameter != nullptr);
+        return parameter;
+    };
+
+    pitchBendRange = get(Parameters::PITCH_BEND_RANGE);
+    glideTime = get(Parameters::GLIDE_TIME);
+    silenceFloor = get(Parameters::SILENCE_FLOOR);
+
+    for (int i = 0; i < Parameters::NUM_SLOTS; ++i)
+    {
+        auto& slot = slots[static_cast<size_t>(i)];
+        slot.volume = get(Parameters::slotVolume(i));
+        slot.pitch = get(Parameters::slotPitch(i));
+        slot.attack = get(Parameters::slotAttack(i));
+        slot.decay = get(Parameters::slotDecay(i));
+        slot.sustain = get(Parameters::slotSustain(i));
+        slot.release = get(Parameters::slotRelease(i));
+        slot.loop = get(Parameters::slotLoop(i));
+        slot.loopMode = get(Parameters::slotLoopMode(i));
+        slot.slice = get(Parameters::slotSlice(i));
+        slot.unisonVoices = get(Parameters::slotUnisonVoices(i));
+        slot.unisonDetune = get(Parameters::slotUnisonDetune(i));
+        slot.unisonSpread = get(Parameters::slotUnisonSpread(i));
+        slot.granular = get(Parameters::slotGranular(i));
+        slot.grainSize = get(Parameters::slotGrainSize(i));
+        slot.grainDensity = get(Parameters::slotGrainDensity(i));
+        slot.grainScan = get(Parameters::slotGrainScan(i));
+        slot.filterType = get(Parameters::slotFilterType(i));
+        slot.filterCutoff = get(Parameters::slotFilterCutoff(i));
+        slot.filterResonance = get(Parameters::slotFilterResonance(i));
+        slot.filterBypass = get(Parameters::slotFilterBypass(i));
+        slot.lfoRate = get(Parameters::slotLfoRate(i));
+        slot.lfoWaveform = get(Parameters::slotLfoWaveform(i));
+    }
+}
 
 OmniverseVoice::OmniverseVoice()
 {
-    for (int i = 0; i < 5; ++i)
-        activeSlotIndices.push_back(i);
 }
 
 void OmniverseVoice::prepareToPlay(double sampleRate, int /*samplesPerBlock*/)
 {
     currentSampleRate = sampleRate;
 
-    // Prepare filters and LFOs
-    for (int i = 0; i < 5; ++i)
-    {
-        filtersL[i].prepare(sampleRate);
-        filtersR[i].prepare(sampleRate);
-        lfos[i].prepare(sampleRate);
-    }
+    // Prepare filter, LFO and grains
+    filter.prepare(sampleRate);
+    lfo.prepare(sampleRate);
+    grainPlayer.prepare(sampleRate);
 }
 
 bool OmniverseVoice::canPlaySound(juce::SynthesiserSound* sound)
@@ -26,94 +64,140 @@ bool OmniverseVoice::canPlaySound(juce::SynthesiserSound* sound)
 }
 
 void OmniverseVoice::startNote(int midiNoteNumber, float velocity,
-                                juce::SynthesiserSound*, int /*currentPitchWheelPosition*/)
+                                juce::SynthesiserSound*, int currentPitchWheelPosition)
 {
+    if (parameters == nullptr)
+    {
+        clearCurrentNote();
+        return;
+    }
+
+    const auto& slotParameters = getSlotParameters();
     midiNote = midiNoteNumber + (octaveShift * 12);
     noteVelocity = velocity;
 
-    // Reset all slot states for new note
-    for (int i = 0; i < 5; ++i)
+    // A stolen voice has already let go of its previous bank in stopNote
+    bank = nextBank;
+    if (bank != nullptr)
+        bank->acquire();
+
+    // Pick the slot's zone for this key and velocity; the voice stays on it
+    // for the whole note
+    auto* slot = bank != nullptr ? bank->getSlot(slotIndex) : nullptr;
+    int velocity7Bit = juce::roundToInt(velocity * 127.0f);
+    zoneIndex = slot != nullptr ? slot->findZone(midiNote, velocity7Bit) : SampleSlot::NO_ZONE;
+    const auto* zone = slot != nullptr ? slot->getZone(zoneIndex) : nullptr;
+    zoneRootKey = zone != nullptr ? zone->mapping.rootKey : ROOT_NOTE;
+
+    // Slice mode: the key picks a slice of the main sample, played untransposed
+    sliceIndex = -1;
+    if (slot != nullptr && read(slotParameters.slice) > 0.5f && slot->getNumSlices() > 0)
     {
-        auto& state = slotStates[i];
-        state.samplePosition = 0.0;
-        state.envelopeTime = 0.0;
-        state.envelopeValue = 0.0f;
-        state.inRelease = false;
-        state.releaseStartValue = 0.0f;
-        state.releaseTime = 0.0;
-        state.isPlaying = true;
+        sliceIndex = midiNoteNumber - SampleSlot::SLICE_BASE_KEY;
+        zoneIndex = 0;
+        zone = slot->getSlice(sliceIndex) != nullptr ? slot->getZone(0) : nullptr;
+        zoneRootKey = midiNoteNumber;
+    }
+
+    pitchWheelMoved(currentPitchWheelPosition);
 
-        // Reset filters and LFOs
-        filtersL[i].reset();
-        filtersR[i].reset();
-        lfos[i].reset();
+    // Glide from the previous note towards this one
+    float glideMs = read(parameters->glideTime);
+    if (glideSourceNote >= 0 && glideSourceNote != midiNote && glideMs > 0.0f)
+    {
+        float glideSamples = (glideMs / 1000.0f) * static_cast<float>(currentSampleRate);
+        glideSemitones = static_cast<float>(glideSourceNote - midiNote);
+        glideStepPerSample = std::abs(glideSemitones) / std::max(glideSamples, 1.0f);
     }
+    else
+    {
+        glideSemitones = 0.0f;
+        glideStepPerSample = 0.0f;
+    }
+    glideSourceNote = -1;
+
+    // Reset slot state for new note
+    state.numLanes = std::clamp(static_cast<int>(read(slotParameters.unisonVoices)), 1, maxUnisonLanes);
+    state.lanePositions.fill(0.0);
+    state.laneDirections.fill(1.0f);
+    state.envelopeTime = 0.0;
+    state.envelopeValue = 0.0f;
+    state.inRelease = false;
+    state.releaseStartValue = 0.0f;
+    state.releaseTime = 0.0;
+    state.isPlaying = zone != nullptr;
+    state.pitchRatio = 1.0f;
+    state.pitchRatioStep = 0.0f;
+    state.volume = 0.0f;
+    state.volumeStep = 0.0f;
+
+    // Reset filter, LFO and grains
+    filter.reset();
+    lfo.reset();
+    grainPlayer.reset();
 
     controlRateCounter = 0;
+    pitchRampPrimed = false;
 }
 
 void OmniverseVoice::stopNote(float /*velocity*/, bool allowTailOff)
 {
     if (allowTailOff)
     {
-        for (int i = 0; i < 5; ++i)
-        {
-            slotStates[i].inRelease = true;
-            slotStates[i].releaseStartValue = slotStates[i].envelopeValue;
-            slotStates[i].releaseTime = 0.0;
-        }
+        state.inRelease = true;
+        state.releaseStartValue = state.envelopeValue;
+        state.releaseTime = 0.0;
     }
     else
     {
-        for (auto& state : slotStates)
-        {
-            state.isPlaying = false;
-        }
-        clearCurrentNote();
+        state.isPlaying = false;
+        finishNote();
     }
 }
 
-void OmniverseVoice::pitchWheelMoved(int /*newPitchWheelValue*/)
+void OmniverseVoice::finishNote()
 {
+    clearCurrentNote();
+
+    // The bank may be freed once its last voice lets go
+    if (bank != nullptr)
+    {
+        bank->release();
+        bank = nullptr;
+    }
 }
 
-void OmniverseVoice::controllerMoved(int /*controllerNumber*/, int /*newControllerValue*/)
+void OmniverseVoice::pitchWheelMoved(int newPitchWheelValue)
 {
+    // 14-bit wheel, 8192 = centre; the bend range applies each control tick
+    float normalised = static_cast<float>(newPitchWheelValue - 8192) / 8192.0f;
+    pitchWheel = std::clamp(normalised, -1.0f, 1.0f);
 }
 
-float OmniverseVoice::getParameter(const juce::String& paramId)
+void OmniverseVoice::controllerMoved(int /*controllerNumber*/, int /*newControllerValue*/)
 {
-    if (apvts == nullptr)
-        return 0.0f;
-
-    auto* param = apvts->getRawParameterValue(paramId);
-    return param != nullptr ? param->load() : 0.0f;
 }
 
-void OmniverseVoice::updateFilterParameters(int slotIndex)
+void OmniverseVoice::updateFilterParameters()
 {
-    if (apvts == nullptr)
-        return;
+    const auto& slotParameters = getSlotParameters();
 
     // Get filter parameters
-    int filterType = static_cast<int>(getParameter(Parameters::slotFilterType(slotIndex)));
-    float baseCutoff = getParameter(Parameters::slotFilterCutoff(slotIndex));
-    float resonance = getParameter(Parameters::slotFilterResonance(slotIndex));
-    bool bypass = getParameter(Parameters::slotFilterBypass(slotIndex)) > 0.5f;
+    int filterType = static_cast<int>(read(slotParameters.filterType));
+    float baseCutoff = read(slotParameters.filterCutoff);
+    float resonance = read(slotParameters.filterResonance);
+    bool bypass = read(slotParameters.filterBypass) > 0.5f;
 
     // Get LFO parameters
-    float lfoRate = getParameter(Parameters::slotLfoRate(slotIndex));
-    float lfoDepth = getParameter(Parameters::slotLfoDepth(slotIndex));
-    int lfoWaveform = static_cast<int>(getParameter(Parameters::slotLfoWaveform(slotIndex)));
+    float lfoRate = read(slotParameters.lfoRate);
+    int lfoWaveform = static_cast<int>(read(slotParameters.lfoWaveform));
 
     // Update LFO
-    lfos[slotIndex].setRate(lfoRate);
-    lfos[slotIndex].setWaveform(static_cast<LFO::Waveform>(lfoWaveform));
+    lfo.setRate(lfoRate);
+    lfo.setWaveform(static_cast<LFO::Waveform>(lfoWaveform));
 
-    // Calculate modulated cutoff
-    float lfoValue = lfos[slotIndex].getCurrentValue(); // -1 to 1
-    float modulationRange = baseCutoff * lfoDepth; // Modulate by percentage of base cutoff
-    float modulatedCutoff = baseCutoff + (lfoValue * modulationRange);
+    // Cutoff modulation (LFO depth included) is a fraction of the base cutoff
+    float modulatedCutoff = baseCutoff * (1.0f + modulation[ModMatrix::Cutoff]);
 
     // Clamp cutoff to valid range
     modulatedCutoff = std::clamp(modulatedCutoff, 20.0f, 20000.0f);
@@ -125,261 +209,579 @@ void OmniverseVoice::updateFilterParameters(int slotIndex)
         case 0: type = SVFilter::Type::LowPass; break;
         case 1: type = SVFilter::Type::HighPass; break;
         case 2: type = SVFilter::Type::BandPass; break;
+        case 3: type = SVFilter::Type::Ladder; break;
         default: type = SVFilter::Type::LowPass; break;
     }
 
-    // Apply to both channels
+    // One coefficient update per tick covers both channels
     if (!bypass)
-    {
-        filtersL[slotIndex].setType(type);
-        filtersL[slotIndex].setCutoff(modulatedCutoff);
-        filtersL[slotIndex].setResonance(resonance);
-
-        filtersR[slotIndex].setType(type);
-        filtersR[slotIndex].setCutoff(modulatedCutoff);
-        filtersR[slotIndex].setResonance(resonance);
-    }
+        filter.setParameters(type, modulatedCutoff, resonance);
 }
 
-float OmniverseVoice::calculateEnvelope(int slotIndex, SlotState& state, bool noteIsHeld)
+void OmniverseVoice::updateSlotControl()
 {
-    float attackMs = getParameter(Parameters::slotAttack(slotIndex));
-    float decayMs = getParameter(Parameters::slotDecay(slotIndex));
-    float sustainDb = getParameter(Parameters::slotSustain(slotIndex));
-    float releaseMs = getParameter(Parameters::slotRelease(slotIndex));
+    if (!latchSlotData())
+        return;
 
-    float attackSamples = (attackMs / 1000.0f) * static_cast<float>(currentSampleRate);
-    float decaySamples = (decayMs / 1000.0f) * static_cast<float>(currentSampleRate);
-    float releaseSamples = (releaseMs / 1000.0f) * static_cast<float>(currentSampleRate);
-    float sustainLevel = juce::Decibels::decibelsToGain(sustainDb);
+    const auto& slotParameters = getSlotParameters();
+    float volumeDb = read(slotParameters.volume);
+    control.volume = juce::Decibels::decibelsToGain(volumeDb) * noteVelocity;
+    control.pitchSemitones = read(slotParameters.pitch);
 
-    if (attackSamples < 1.0f) attackSamples = 1.0f;
-    if (decaySamples < 1.0f) decaySamples = 1.0f;
-    if (releaseSamples < 1.0f) releaseSamples = 1.0f;
+    float samplesPerMs = static_cast<float>(currentSampleRate) / 1000.0f;
+    control.attackSamples = std::max(read(slotParameters.attack) * samplesPerMs, 1.0f);
+    control.decaySamples = std::max(read(slotParameters.decay) * samplesPerMs, 1.0f);
+    control.releaseSamples = std::max(read(slotParameters.release) * samplesPerMs, 1.0f);
+    control.sustainLevel = juce::Decibels::decibelsToGain(read(slotParameters.sustain));
 
-    if (state.inRelease)
+    control.filterBypass = control.frozen || read(slotParameters.filterBypass) > 0.5f;
+    control.loopEnabled = read(slotParameters.loop) > 0.5f;
+    control.pingPong = read(slotParameters.loopMode) > 0.5f;
+    control.granular = read(slotParameters.granular) > 0.5f;
+
+    if (control.granular)
     {
-        float releaseProgress = static_cast<float>(state.releaseTime) / releaseSamples;
-        if (releaseProgress >= 1.0f)
-        {
-            state.isPlaying = false;
-            return 0.0f;
-        }
-        return state.releaseStartValue * (1.0f - releaseProgress);
+        grainPlayer.setParameters(read(slotParameters.grainSize),
+                                  read(slotParameters.grainDensity),
+                                  read(slotParameters.grainScan));
     }
 
-    double envTime = state.envelopeTime;
+    updateUnisonLanes();
+}
+
+bool OmniverseVoice::latchSlotData()
+{
+    auto* slot = bank->getSlot(slotIndex);
+
+    const auto* zone = slot != nullptr && slot->isLoaded() ? slot->getZone(zoneIndex) : nullptr;
 
-    if (envTime < attackSamples)
+    // A frozen slot plays its pre-rendered audio, which already has the filter
+    // and LFO baked in; only the main zone is frozen, and slices play live.
+    // Otherwise in/out points are resolved by the slot when their parameters change.
+    const auto* frozenSample = zone != nullptr && zoneIndex == 0 && sliceIndex < 0 && slot->isFrozen()
+                                   ? slot->getFrozenSample() : nullptr;
+    control.frozen = frozenSample != nullptr;
+    const auto* audio = frozenSample != nullptr ? &frozenSample->data : (zone != nullptr ? &zone->audioData : nullptr);
+    const auto* region = frozenSample != nullptr ? &frozenSample->region : (zone != nullptr ? &slot->getPlaybackRegion(*zone) : nullptr);
+
+    if (sliceIndex >= 0)
+        region = zone != nullptr ? slot->getSlice(sliceIndex) : nullptr;
+
+    // The region can briefly lag a freshly loaded buffer
+    bool valid = region != nullptr && region->length > 0 && region->outSample <= audio->getNumSamples();
+
+   #if OMNIVERSE_INTERLEAVED_SAMPLES
+    const auto* interleaved = frozenSample != nullptr ? &frozenSample->interleaved
+                                                      : (zone != nullptr ? &zone->interleavedData : nullptr);
+    valid = valid && interleaved->numFrames >= region->outSample;
+   #endif
+
+    if (!valid)
     {
-        return static_cast<float>(envTime / attackSamples);
+        control.region = nullptr;
+        control.audio = nullptr;
+        control.frames = nullptr;
+        control.playableLength = 0;
+        return false;
     }
 
-    double decayPosition = envTime - attackSamples;
-    if (decayPosition < decaySamples)
+    control.region = region;
+    control.audio = audio;
+   #if OMNIVERSE_INTERLEAVED_SAMPLES
+    control.frames = interleaved->frames();
+   #endif
+    control.playableLength = region->length;
+    return true;
+}
+
+void OmniverseVoice::updateUnisonLanes()
+{
+    int numLanes = state.numLanes;
+
+    if (numLanes == 1)
     {
-        float decayProgress = static_cast<float>(decayPosition / decaySamples);
-        return 1.0f - (decayProgress * (1.0f - sustainLevel));
+        control.laneRatios[0] = 1.0f;
+        control.laneGainsL[0] = 1.0f;
+        control.laneGainsR[0] = 1.0f;
+        return;
     }
 
-    if (noteIsHeld)
+    float detuneSemitones = read(getSlotParameters().unisonDetune) / 100.0f;
+    float spread = read(getSlotParameters().unisonSpread);
+
+    // Keeps the summed stack at roughly the level of a single lane
+    float laneLevel = 1.0f / std::sqrt(static_cast<float>(numLanes));
+
+    for (int lane = 0; lane < numLanes; ++lane)
     {
-        return sustainLevel;
-    }
+        // Lanes spread evenly over -1..1 in both pitch and pan
+        float offset = 2.0f * static_cast<float>(lane) / static_cast<float>(numLanes - 1) - 1.0f;
 
-    return sustainLevel;
+        control.laneRatios[lane] = FastMath::semitonesToRatio(offset * detuneSemitones);
+
+        // Equal-power pan, unity at centre
+        float panAngle = (offset * spread + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+        control.laneGainsL[lane] = std::cos(panAngle) * juce::MathConstants<float>::sqrt2 * laneLevel;
+        control.laneGainsR[lane] = std::sin(panAngle) * juce::MathConstants<float>::sqrt2 * laneLevel;
+    }
 }
 
-void OmniverseVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
-                                      int startSample, int numSamples)
+void OmniverseVoice::updateModulation()
 {
-    if (sampleSlots == nullptr || apvts == nullptr)
+    if (modMatrix == nullptr || modMatrix->isEmpty())
+    {
+        modulation.fill(0.0f);
         return;
+    }
+
+    ModMatrix::Sources sources;
+    sources[ModMatrix::Lfo] = lfo.getCurrentValue();
+    sources[ModMatrix::Velocity] = noteVelocity;
+    sources[ModMatrix::Envelope] = state.envelopeValue;
+    sources[ModMatrix::Note] = static_cast<float>(midiNote - ROOT_NOTE) / 64.0f;
+    sources[ModMatrix::ModWheel] = modWheel;
+
+    modMatrix->evaluate(sources, modulation);
 
-    if (!isVoiceActive())
+    if (control.region == nullptr)
         return;
 
-    bool anySlotStillPlaying = false;
+    // Volume and pan scale this tick's gains, which are rebuilt every tick
+    control.volume *= std::max(1.0f + modulation[ModMatrix::Volume], 0.0f);
 
-    for (int sample = 0; sample < numSamples; ++sample)
+    float pan = std::clamp(modulation[ModMatrix::Pan], -1.0f, 1.0f);
+    if (pan != 0.0f)
     {
-        // Update filter/LFO parameters at control rate
-        if (++controlRateCounter >= CONTROL_RATE_DIVIDER)
-        {
-            controlRateCounter = 0;
-            for (int slotIdx : activeSlotIndices)
-            {
-                updateFilterParameters(slotIdx);
-            }
-        }
+        float panL = std::min(1.0f - pan, 1.0f);
+        float panR = std::min(1.0f + pan, 1.0f);
 
-        // Advance LFOs every sample
-        for (int slotIdx : activeSlotIndices)
+        for (int lane = 0; lane < state.numLanes; ++lane)
         {
-            lfos[slotIdx].process();
+            control.laneGainsL[lane] *= panL;
+            control.laneGainsR[lane] *= panR;
         }
+    }
 
-        float leftSample = 0.0f;
-        float rightSample = 0.0f;
+    // In-point only moves where the note starts, as a fraction of the region
+    float inPoint = modulation[ModMatrix::InPoint];
+    if (!pitchRampPrimed && inPoint > 0.0f && !control.granular)
+    {
+        double offset = std::min(inPoint, 1.0f) * static_cast<double>(control.playableLength - 1);
+        for (int lane = 0; lane < state.numLanes; ++lane)
+            state.lanePositions[lane] += offset;
+    }
+}
 
-        for (int slotIdx : activeSlotIndices)
-        {
-            auto* slot = (*sampleSlots)[slotIdx];
-            if (slot == nullptr || !slot->isLoaded())
-                continue;
+void OmniverseVoice::updateControlTick()
+{
+    controlRateDivider = nextControlRateDivider;
+
+    // Move the glide offset towards zero
+    float glideStep = glideStepPerSample * static_cast<float>(controlRateDivider);
+    if (glideSemitones > 0.0f)
+        glideSemitones = std::max(glideSemitones - glideStep, 0.0f);
+    else if (glideSemitones < 0.0f)
+        glideSemitones = std::min(glideSemitones + glideStep, 0.0f);
+
+    float pitchBendSemitones = pitchWheel * read(parameters->pitchBendRange);
+    float notePitch = static_cast<float>(midiNote - zoneRootKey) + pitchBendSemitones + glideSemitones;
+
+    // Volume modulation can lift the level past full slot volume, so with a
+    // volume routing the release always runs to its end
+    if (modMatrix != nullptr && modMatrix->targets(ModMatrix::Volume))
+        silenceFloorEnvelope = 0.0f;
+    else
+        silenceFloorEnvelope = juce::Decibels::decibelsToGain(read(parameters->silenceFloor))
+                             / (MAX_SLOT_GAIN * std::max(noteVelocity, 1.0e-6f));
 
-            auto& state = slotStates[slotIdx];
+    updateSlotControl();
+    updateModulation();
 
-            if (!state.isPlaying)
-                continue;
+    if (!control.frozen)
+        updateFilterParameters();
 
-            const auto& audioData = slot->getAudioData();
-            int numSlotSamples = audioData.getNumSamples();
-            int numChannels = audioData.getNumChannels();
+    // Pitch ratio is evaluated once per tick and ramped linearly in between
+    float modPitch = modulation[ModMatrix::Pitch] * MOD_PITCH_RANGE;
+    float targetRatio = FastMath::semitonesToRatio(notePitch + control.pitchSemitones + modPitch);
 
-            if (numSlotSamples == 0)
-                continue;
+    if (pitchRampPrimed)
+    {
+        state.pitchRatioStep = (targetRatio - state.pitchRatio) / static_cast<float>(controlRateDivider);
+        state.volumeStep = (control.volume - state.volume) / static_cast<float>(controlRateDivider);
+    }
+    else
+    {
+        state.pitchRatio = targetRatio;
+        state.pitchRatioStep = 0.0f;
+        state.volume = control.volume;
+        state.volumeStep = 0.0f;
+    }
 
-            // Get in/out points (0-100%)
-            float inPointPercent = getParameter(Parameters::slotInPoint(slotIdx));
-            float outPointPercent = getParameter(Parameters::slotOutPoint(slotIdx));
+    pitchRampPrimed = true;
+}
 
-            // Ensure in < out with minimum 1% gap
-            if (outPointPercent <= inPointPercent + 1.0f)
-                outPointPercent = inPointPercent + 1.0f;
+float OmniverseVoice::calculateEnvelope()
+{
+    if (state.inRelease)
+    {
+        float releaseProgress = static_cast<float>(state.releaseTime) / control.releaseSamples;
+        if (releaseProgress >= 1.0f)
+        {
+            state.isPlaying = false;
+            return 0.0f;
+        }
+        // Never rises, even if the release time is lengthened mid-release
+        return std::min(state.releaseStartValue * (1.0f - releaseProgress), state.envelopeValue);
+    }
 
-            // Calculate sample positions for in/out points
-            int inSample = static_cast<int>((inPointPercent / 100.0f) * numSlotSamples);
-            int outSample = static_cast<int>((outPointPercent / 100.0f) * numSlotSamples);
+    double envTime = state.envelopeTime;
 
-            // Clamp to valid range
-            inSample = std::clamp(inSample, 0, numSlotSamples - 1);
-            outSample = std::clamp(outSample, inSample + 1, numSlotSamples);
+    if (envTime < control.attackSamples)
+    {
+        return static_cast<float>(envTime / control.attackSamples);
+    }
 
-            // Enforce minimum playable length (at least 64 samples to prevent clicks)
-            int playableLength = outSample - inSample;
-            if (playableLength < 64)
-            {
-                outSample = std::min(inSample + 64, numSlotSamples);
-                playableLength = outSample - inSample;
-            }
+    double decayPosition = envTime - control.attackSamples;
+    if (decayPosition < control.decaySamples)
+    {
+        float decayProgress = static_cast<float>(decayPosition / control.decaySamples);
+        return 1.0f - (decayProgress * (1.0f - control.sustainLevel));
+    }
 
-            float pitchSemitones = getParameter(Parameters::slotPitch(slotIdx));
-            float totalPitchShift = (midiNote - ROOT_NOTE) + pitchSemitones;
-            double pitchRatio = std::pow(2.0, totalPitchShift / 12.0);
+    return control.sustainLevel;
+}
 
-            bool noteIsHeld = !state.inRelease;
-            float envelope = calculateEnvelope(slotIdx, state, noteIsHeld);
-            state.envelopeValue = envelope;
+template <bool Interpolate>
+void OmniverseVoice::renderSlot(float* outL, float* outR, int numSamples)
+{
+    // Nothing playable (empty slot or region not ready): the voice is done
+    if (control.playableLength == 0)
+    {
+        state.isPlaying = false;
+        return;
+    }
 
-            float volumeDb = getParameter(Parameters::slotVolume(slotIdx));
-            float volume = juce::Decibels::decibelsToGain(volumeDb) * noteVelocity;
+    const auto& audioData = *control.audio;
+    const int lastFrame = audioData.getNumSamples() - 1;
+    const float* dataL = audioData.getReadPointer(0);
+    const float* dataR = audioData.getNumChannels() >= 2 ? audioData.getReadPointer(1) : dataL;
+    const float* frames = control.frames;
+
+    const auto& region = *control.region;
+    const int length = control.playableLength;
+
+    // Positions are in playback order; map them to frames in the buffer
+    const int baseFrame = isReversed ? region.outSample - 1 : region.inSample;
+    const int frameStep = isReversed ? -1 : 1;
+
+    // A forward-wrapping loop reads its tail from the precomputed crossfade
+    const auto& crossfade = isReversed ? region.reverse : region.forward;
+    const bool useCrossfade = control.loopEnabled && !control.pingPong && crossfade.length > 0;
+    const int crossfadeStart = useCrossfade ? length - crossfade.length : length;
+    const float* fadeL = useCrossfade ? crossfade.data.getReadPointer(0) : nullptr;
+    const float* fadeR = useCrossfade && crossfade.data.getNumChannels() >= 2 ? crossfade.data.getReadPointer(1) : fadeL;
+
+    // Granular mode: grains for the whole chunk are mixed up front, then go
+    // through the same envelope and filter as the direct read below
+    bool grainsPlaying = false;
+    if (control.granular && state.isPlaying)
+    {
+        std::fill_n(grainBufferL.begin(), numSamples, 0.0f);
+        std::fill_n(grainBufferR.begin(), numSamples, 0.0f);
 
-            // Calculate read position within the in/out range
-            double readPosition;
-            if (isReversed)
-            {
-                // Reverse: start from out point, go towards in point
-                readPosition = (outSample - 1) - state.samplePosition;
-            }
-            else
-            {
-                // Normal: start from in point, go towards out point
-                readPosition = inSample + state.samplePosition;
-            }
+        GrainPlayer::Source source { dataL, dataR, frames, baseFrame, frameStep, lastFrame, length,
+                                     control.loopEnabled && !state.inRelease };
+        grainsPlaying = grainPlayer.render(source, state.pitchRatio,
+                                           grainBufferL.data(), grainBufferR.data(), numSamples);
+    }
 
-            // Check if we're within the playable range
-            bool withinRange = isReversed
-                ? (readPosition >= inSample && readPosition < outSample)
-                : (readPosition >= inSample && readPosition < outSample);
+    // Per-lane reads for one sample, padded to whole SIMD registers; the
+    // padding stays silent
+    alignas(LANE_ALIGNMENT) std::array<float, MAX_UNISON> laneL {};
+    alignas(LANE_ALIGNMENT) std::array<float, MAX_UNISON> laneR {};
+    alignas(LANE_ALIGNMENT) std::array<float, MAX_UNISON> laneSlopeL {};
+    alignas(LANE_ALIGNMENT) std::array<float, MAX_UNISON> laneSlopeR {};
+    alignas(LANE_ALIGNMENT) std::array<float, MAX_UNISON> laneFracs {};
+    const int laneSlots = (state.numLanes + LANE_WIDTH - 1) / LANE_WIDTH * LANE_WIDTH;
 
-            if (withinRange && state.isPlaying)
-            {
-                anySlotStillPlaying = true;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        // Advance LFO every sample (a frozen slot has it baked in)
+        if (!control.frozen)
+            lfo.process();
 
-                int pos0 = static_cast<int>(readPosition);
-                int pos1 = pos0 + 1;
-                float frac = static_cast<float>(readPosition - pos0);
+        if (!state.isPlaying)
+            break;
 
-                if (pos1 >= numSlotSamples)
-                    pos1 = numSlotSamples - 1;
+        float envelope = calculateEnvelope();
+        state.envelopeValue = envelope;
 
-                float leftVal = 0.0f;
-                float rightVal = 0.0f;
+        // A released envelope never rises again, but slot volume can be
+        // turned back up at any time, so the note only ends once it would
+        // be under the floor even at full slot volume
+        if (state.inRelease && envelope < silenceFloorEnvelope)
+        {
+            state.isPlaying = false;
+            break;
+        }
+
+        // All unison lanes read the same buffer at their own positions and
+        // share the envelope, filter and control work below
+        float leftVal = 0.0f;
+        float rightVal = 0.0f;
+        bool anyLaneInRange = false;
+        const bool wrapLoop = control.loopEnabled && !state.inRelease;
+
+        if (control.granular)
+        {
+            leftVal = grainBufferL[static_cast<size_t>(i)];
+            rightVal = grainBufferR[static_cast<size_t>(i)];
+            anyLaneInRange = grainsPlaying;
+        }
+        else
+        {
+            // Gather each lane's frame and slope. Lanes read at unrelated
+            // positions, so this part stays scalar; a lane out of range
+            // contributes silence.
+            for (int lane = 0; lane < state.numLanes; ++lane)
+            {
+                double position = state.lanePositions[lane];
 
-                if (numChannels >= 1)
+                if (position < 0.0 || position >= length)
                 {
-                    const float* channelData = audioData.getReadPointer(0);
-                    leftVal = channelData[pos0] * (1.0f - frac) + channelData[pos1] * frac;
+                    laneL[lane] = laneR[lane] = 0.0f;
+                    laneSlopeL[lane] = laneSlopeR[lane] = 0.0f;
+                    continue;
                 }
 
-                if (numChannels >= 2)
+                anyLaneInRange = true;
+
+                int index0 = static_cast<int>(position);
+                laneFracs[lane] = static_cast<float>(position - index0);
+
+                if (index0 >= crossfadeStart)
                 {
-                    const float* channelData = audioData.getReadPointer(1);
-                    rightVal = channelData[pos0] * (1.0f - frac) + channelData[pos1] * frac;
+                    int j = index0 - crossfadeStart;
+                    laneL[lane] = fadeL[j];
+                    laneR[lane] = fadeR[j];
+
+                    if constexpr (Interpolate)
+                    {
+                        laneSlopeL[lane] = fadeL[j + 1] - fadeL[j];
+                        laneSlopeR[lane] = fadeR[j + 1] - fadeR[j];
+                    }
                 }
                 else
                 {
-                    rightVal = leftVal;
+                   #if OMNIVERSE_INTERLEAVED_SAMPLES
+                    // L/R share a cache line; guard frames make the next-frame read safe
+                    const float* frame0 = frames + 2 * (baseFrame + frameStep * index0);
+                    laneL[lane] = frame0[0];
+                    laneR[lane] = frame0[1];
+
+                    if constexpr (Interpolate)
+                    {
+                        const float* frame1 = frame0 + 2 * frameStep;
+                        laneSlopeL[lane] = frame1[0] - frame0[0];
+                        laneSlopeR[lane] = frame1[1] - frame0[1];
+                    }
+                   #else
+                    int pos0 = std::clamp(baseFrame + frameStep * index0, 0, lastFrame);
+                    laneL[lane] = dataL[pos0];
+                    laneR[lane] = dataR[pos0];
+
+                    if constexpr (Interpolate)
+                    {
+                        int pos1 = std::clamp(pos0 + frameStep, 0, lastFrame);
+                        laneSlopeL[lane] = dataL[pos1] - dataL[pos0];
+                        laneSlopeR[lane] = dataR[pos1] - dataR[pos0];
+                    }
+                   #endif
                 }
+            }
 
-                // Apply filter (if not bypassed)
-                bool filterBypass = getParameter(Parameters::slotFilterBypass(slotIdx)) > 0.5f;
-                if (!filterBypass)
+            // Interpolate, pan and sum the lanes a SIMD register at a time
+            auto sumL = LaneRegister::expand(0.0f);
+            auto sumR = LaneRegister::expand(0.0f);
+
+            for (int lane = 0; lane < laneSlots; lane += LANE_WIDTH)
+            {
+                auto left = LaneRegister::fromRawArray(laneL.data() + lane);
+                auto right = LaneRegister::fromRawArray(laneR.data() + lane);
+
+                if constexpr (Interpolate)
                 {
-                    leftVal = filtersL[slotIdx].process(leftVal);
-                    rightVal = filtersR[slotIdx].process(rightVal);
+                    auto fracs = LaneRegister::fromRawArray(laneFracs.data() + lane);
+                    left += fracs * LaneRegister::fromRawArray(laneSlopeL.data() + lane);
+                    right += fracs * LaneRegister::fromRawArray(laneSlopeR.data() + lane);
                 }
 
-                float gain = envelope * volume;
-                leftSample += leftVal * gain;
-                rightSample += rightVal * gain;
-
-                // Sanitize to prevent NaN/Inf propagation
-                if (!std::isfinite(leftSample)) leftSample = 0.0f;
-                if (!std::isfinite(rightSample)) rightSample = 0.0f;
+                sumL += left * LaneRegister::fromRawArray(control.laneGainsL.data() + lane);
+                sumR += right * LaneRegister::fromRawArray(control.laneGainsR.data() + lane);
             }
-            else if (state.samplePosition >= playableLength)
+
+            leftVal = sumL.sum();
+            rightVal = sumR.sum();
+
+            for (int lane = 0; lane < state.numLanes; ++lane)
             {
-                // Reached end of playable region
-                if (!state.inRelease)
+                double position = state.lanePositions[lane]
+                                + state.laneDirections[lane] * (state.pitchRatio * control.laneRatios[lane]);
+
+                // Loop wrap: loop points were resolved up front, so this is a plain wrap
+                if (wrapLoop)
                 {
-                    state.inRelease = true;
-                    state.releaseStartValue = state.envelopeValue;
-                    state.releaseTime = 0.0;
+                    if (control.pingPong)
+                    {
+                        double turnPoint = static_cast<double>(length - 1);
+                        if (position >= turnPoint)
+                        {
+                            position = 2.0 * turnPoint - position;
+                            state.laneDirections[lane] = -1.0f;
+                        }
+                        else if (position < 0.0)
+                        {
+                            position = -position;
+                            state.laneDirections[lane] = 1.0f;
+                        }
+                    }
+                    else if (position >= length)
+                    {
+                        position -= length;
+                    }
                 }
+
+                state.lanePositions[lane] = position;
             }
+        }
 
-            state.samplePosition += pitchRatio;
-            state.envelopeTime += 1.0;
+        if (anyLaneInRange)
+        {
+            // Apply filter; bypass still takes the filter's latency
+            if (!control.filterBypass)
+                filter.process(leftVal, rightVal);
+            else
+                filter.processBypassed(leftVal, rightVal);
 
-            if (state.inRelease)
-            {
-                state.releaseTime += 1.0;
-            }
+            float gain = envelope * state.volume;
+            leftVal *= gain;
+            rightVal *= gain;
 
-            // Check for loop mode
-            bool loopEnabled = getParameter(Parameters::slotLoop(slotIdx)) > 0.5f;
-            if (loopEnabled && !state.inRelease && state.samplePosition >= playableLength)
-            {
-                // Loop back to start of playable region
-                state.samplePosition = std::fmod(state.samplePosition, static_cast<double>(playableLength));
-            }
+            // Sanitize to prevent NaN/Inf propagation
+            if (!std::isfinite(leftVal)) leftVal = 0.0f;
+            if (!std::isfinite(rightVal)) rightVal = 0.0f;
 
-            if (state.isPlaying && envelope > 0.0001f)
-            {
-                anySlotStillPlaying = true;
-            }
+            outL[i] += leftVal;
+            if (outR != nullptr)
+                outR[i] += rightVal;
+        }
+        else
+        {
+            // Every lane reached the end of the playable region: nothing more
+            // can be read, so the slot is done rather than releasing silence
+            state.isPlaying = false;
+            break;
         }
 
-        if (outputBuffer.getNumChannels() >= 1)
-            outputBuffer.addSample(0, startSample + sample, leftSample);
-        if (outputBuffer.getNumChannels() >= 2)
-            outputBuffer.addSample(1, startSample + sample, rightSample);
+        state.pitchRatio += state.pitchRatioStep;
+        state.volume += state.volumeStep;
+        state.envelopeTime += 1.0;
+
+        if (state.inRelease)
+        {
+            state.releaseTime += 1.0;
+        }
     }
+}
+
+void OmniverseVoice::prefetchBlock(int numSamples) const
+{
+    // Each voice reads its own far-apart span of long samples. Called after
+    // a block is rendered, so the lane positions are where the next block
+    // starts; request the frames it will touch while the other voices render
+    if (!state.isPlaying || control.playableLength == 0 || control.granular)
+        return;
+
+    const auto& audioData = *control.audio;
+    const auto& region = *control.region;
+    const int lastFrame = audioData.getNumSamples() - 1;
+   #if !OMNIVERSE_INTERLEAVED_SAMPLES
+    const float* dataL = audioData.getReadPointer(0);
+    const float* dataR = audioData.getNumChannels() >= 2 ? audioData.getReadPointer(1) : nullptr;
+   #endif
 
-    if (!anySlotStillPlaying)
+    for (int lane = 0; lane < state.numLanes; ++lane)
     {
-        clearCurrentNote();
+        double speed = std::abs(state.pitchRatio * control.laneRatios[lane]);
+        int span = std::min(static_cast<int>(numSamples * speed) + 2, MAX_PREFETCH_FRAMES);
+
+        // Playback-order range this lane covers, then mapped to buffer frames
+        double position = state.lanePositions[lane];
+        double low = state.laneDirections[lane] > 0.0f ? position : position - span;
+        int first = std::clamp(static_cast<int>(low), 0, control.playableLength - 1);
+        int last = std::clamp(first + span, 0, control.playableLength - 1);
+
+        int frameA = isReversed ? region.outSample - 1 - first : region.inSample + first;
+        int frameB = isReversed ? region.outSample - 1 - last : region.inSample + last;
+        int firstFrame = std::clamp(std::min(frameA, frameB), 0, lastFrame);
+        int lastFrameToFetch = std::clamp(std::max(frameA, frameB), 0, lastFrame);
+
+       #if OMNIVERSE_INTERLEAVED_SAMPLES
+        Prefetch::range(control.frames, 2 * firstFrame, 2 * lastFrameToFetch + 1);
+       #else
+        Prefetch::range(dataL, firstFrame, lastFrameToFetch);
+        if (dataR != nullptr)
+            Prefetch::range(dataR, firstFrame, lastFrameToFetch);
+       #endif
+    }
+}
+
+void OmniverseVoice::renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
+                                      int startSample, int numSamples)
+{
+    if (parameters == nullptr)
+        return;
+
+    if (!isVoiceActive() || outputBuffer.getNumChannels() < 1)
+        return;
+
+    float* outL = outputBuffer.getWritePointer(0, startSample);
+    float* outR = outputBuffer.getNumChannels() >= 2 ? outputBuffer.getWritePointer(1, startSample) : nullptr;
+    const int blockSize = numSamples;
+
+    // Slot data is only guaranteed alive for the block that took it (see
+    // Published), so a block starting mid-tick takes it afresh
+    if (controlRateCounter != 0)
+        latchSlotData();
+
+    // Render in chunks aligned to the control rate so parameter, filter and
+    // pitch updates happen exactly once per tick
+    while (numSamples > 0 && state.isPlaying)
+    {
+        if (controlRateCounter == 0)
+            updateControlTick();
+
+        int chunk = std::min(numSamples, controlRateDivider - controlRateCounter);
+
+        if (interpolate)
+            renderSlot<true>(outL, outR, chunk);
+        else
+            renderSlot<false>(outL, outR, chunk);
+
+        controlRateCounter = (controlRateCounter + chunk) % controlRateDivider;
+        outL += chunk;
+        if (outR != nullptr)
+            outR += chunk;
+        numSamples -= chunk;
     }
+
+    // A finished slot frees its voice straight away, even while the note is held
+    if (!state.isPlaying)
+    {
+        finishNote();
+        return;
+    }
+
+    // Assumes the next block is the same size as this one
+    prefetchBlock(blockSize);
 }
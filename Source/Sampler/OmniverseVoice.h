@@ -2,17 +2,66 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <juce_dsp/juce_dsp.h>
 #include "SampleSlot.h"
+#include "SlotBank.h"
+#include "GrainPlayer.h"
 #include "../DSP/SVFilter.h"
 #include "../DSP/LFO.h"
+#include "../DSP/ModMatrix.h"
+#include "../Utils/Parameters.h"
 
 class OmniverseVoice : public juce::SynthesiserVoice
 {
 public:
+    static constexpr int MAX_UNISON = 8;
+
+    // Control work (filter, pitch, parameters) runs once per this many samples
+    static constexpr int CONTROL_RATE_DIVIDER = 32;
+    static constexpr int MAX_CONTROL_RATE_DIVIDER = 64;
+
+    // Parameters of one slot, as read by its voices
+    struct SlotParameters
+    {
+        std::atomic<float>* volume = nullptr;
+        std::atomic<float>* pitch = nullptr;
+        std::atomic<float>* attack = nullptr;
+        std::atomic<float>* decay = nullptr;
+        std::atomic<float>* sustain = nullptr;
+        std::atomic<float>* release = nullptr;
+        std::atomic<float>* loop = nullptr;
+        std::atomic<float>* loopMode = nullptr;
+        std::atomic<float>* slice = nullptr;
+        std::atomic<float>* unisonVoices = nullptr;
+        std::atomic<float>* unisonDetune = nullptr;
+        std::atomic<float>* unisonSpread = nullptr;
+        std::atomic<float>* granular = nullptr;
+        std::atomic<float>* grainSize = nullptr;
+        std::atomic<float>* grainDensity = nullptr;
+        std::atomic<float>* grainScan = nullptr;
+        std::atomic<float>* filterType = nullptr;
+        std::atomic<float>* filterCutoff = nullptr;
+        std::atomic<float>* filterResonance = nullptr;
+        std::atomic<float>* filterBypass = nullptr;
+        std::atomic<float>* lfoRate = nullptr;
+        std::atomic<float>* lfoWaveform = nullptr;
+    };
+
+    // Everything a voice reads from the APVTS, looked up once by the sampler
+    // and shared by all voices, so control ticks never build parameter IDs
+    struct VoiceParameters
+    {
+        std::atomic<float>* pitchBendRange = nullptr;
+        std::atomic<float>* glideTime = nullptr;
+        std::atomic<float>* silenceFloor = nullptr;
+        std::array<SlotParameters, Parameters::NUM_SLOTS> slots {};
+
+        void resolve(juce::AudioProcessorValueTreeState& apvts);
+    };
+
     OmniverseVoice();
 
-    void setSlots(std::array<SampleSlot*, 5>* slots) { sampleSlots = slots; }
-    void setAPVTS(juce::AudioProcessorValueTreeState* apvtsPtr) { apvts = apvtsPtr; }
+    void setParameters(const VoiceParameters* voiceParameters) { parameters = voiceParameters; }
 
     void prepareToPlay(double sampleRate, int samplesPerBlock);
 
@@ -27,38 +76,130 @@ public:
     void renderNextBlock(juce::AudioBuffer<float>& outputBuffer,
                         int startSample, int numSamples) override;
 
-    void setActiveSlots(const std::vector<int>& slots) { activeSlotIndices = slots; }
+    // The slot this voice renders and the bank it comes from; each layered
+    // slot of a note gets its own voice. The bank is taken at the next
+    // startNote and held until the voice finishes.
+    void setSlot(int index, SlotBank* slotBank) { slotIndex = index; nextBank = slotBank; }
+    int getSlot() const { return slotIndex; }
+    bool isPlayingSlot(const SlotBank* slotBank, int index) const { return isVoiceActive() && bank == slotBank && slotIndex == index; }
     void setReverse(bool reverse) { isReversed = reverse; }
     void setOctaveShift(int shift) { octaveShift = shift; }
 
+    // Note to glide from on the next startNote (-1 = no glide)
+    void setGlideSourceNote(int note) { glideSourceNote = note; }
+
+    // Compiled routing of the voice's slot, owned by the sampler; read each control tick
+    void setModMatrix(const ModMatrix* matrix) { modMatrix = matrix; }
+
+    // Mod wheel position (0-1), kept by every voice so new notes start with it
+    void setModWheel(float value) { modWheel = value; }
+
+    // Quality traded for CPU under load. Interpolation and control rate apply
+    // from the next control tick, the unison cap from the next note.
+    void setQuality(bool interpolateSamples, int controlRate, int unisonLaneLimit)
+    {
+        interpolate = interpolateSamples;
+        nextControlRateDivider = std::clamp(controlRate, 1, MAX_CONTROL_RATE_DIVIDER);
+        maxUnisonLanes = std::clamp(unisonLaneLimit, 1, MAX_UNISON);
+    }
+
 private:
+    // Unison lanes are mixed a SIMD register of lanes at a time
+    using LaneRegister = juce::dsp::SIMDRegister<float>;
+    static constexpr int LANE_WIDTH = static_cast<int>(LaneRegister::SIMDNumElements);
+    static constexpr size_t LANE_ALIGNMENT = sizeof(LaneRegister);
+    static_assert(MAX_UNISON % LANE_WIDTH == 0, "Lane arrays must hold whole registers");
+
+    // Playback state of the voice's slot for the current note
     struct SlotState
     {
-        double samplePosition = 0.0;
+        // Unison lanes (SoA): read position and direction (+1 / -1 for ping-pong)
+        std::array<double, MAX_UNISON> lanePositions {};
+        std::array<float, MAX_UNISON> laneDirections {};
+        int numLanes = 1;
+
         double envelopeTime = 0.0;
         float envelopeValue = 0.0f;
         bool inRelease = false;
         float releaseStartValue = 0.0f;
         double releaseTime = 0.0;
         bool isPlaying = false;
-    };
-
-    float calculateEnvelope(int slotIndex, SlotState& state, bool noteIsHeld);
-    float getParameter(const juce::String& paramId);
-    void updateFilterParameters(int slotIndex);
 
-    std::array<SampleSlot*, 5>* sampleSlots = nullptr;
-    juce::AudioProcessorValueTreeState* apvts = nullptr;
+        // Playback ratio, ramped linearly between control ticks
+        float pitchRatio = 1.0f;
+        float pitchRatioStep = 0.0f;
 
-    std::array<SlotState, 5> slotStates;
-    std::vector<int> activeSlotIndices;
+        // Slot volume x velocity, ramped the same way so volume automation
+        // doesn't step every tick
+        float volume = 0.0f;
+        float volumeStep = 0.0f;
+    };
 
-    // Per-slot filters (stereo)
-    std::array<SVFilter, 5> filtersL;
-    std::array<SVFilter, 5> filtersR;
+    // Slot parameter snapshot, refreshed once per control tick; the sample
+    // and region pointers are also taken again at the start of every block
+    struct SlotControl
+    {
+        const SampleSlot::PlaybackRegion* region = nullptr;
+        const juce::AudioBuffer<float>* audio = nullptr;
+        const float* frames = nullptr; // interleaved frame 0, when enabled
+        int playableLength = 0;
+        float volume = 1.0f;
+        float pitchSemitones = 0.0f;
+        float attackSamples = 1.0f;
+        float decaySamples = 1.0f;
+        float sustainLevel = 1.0f;
+        float releaseSamples = 1.0f;
+        bool filterBypass = true;
+        bool loopEnabled = false;
+        bool pingPong = false;
+        bool granular = false;
+        bool frozen = false;
+
+        // Per-lane detune ratio and stereo gains
+        std::array<float, MAX_UNISON> laneRatios {};
+        alignas(LANE_ALIGNMENT) std::array<float, MAX_UNISON> laneGainsL {};
+        alignas(LANE_ALIGNMENT) std::array<float, MAX_UNISON> laneGainsR {};
+    };
 
-    // Per-slot LFOs
-    std::array<LFO, 5> lfos;
+    float calculateEnvelope();
+    const SlotParameters& getSlotParameters() const { return parameters->slots[static_cast<size_t>(slotIndex)]; }
+    static float read(const std::atomic<float>* parameter) { return parameter->load(std::memory_order_relaxed); }
+    void updateControlTick();
+    void updateSlotControl();
+    bool latchSlotData();
+    void updateUnisonLanes();
+    void updateModulation();
+    void updateFilterParameters();
+    template <bool Interpolate>
+    void renderSlot(float* outL, float* outR, int numSamples);
+    void prefetchBlock(int numSamples) const;
+    void finishNote();
+
+    SlotBank* bank = nullptr;
+    SlotBank* nextBank = nullptr;
+    const VoiceParameters* parameters = nullptr;
+
+    int slotIndex = 0;
+
+    // Zone of the slot chosen at note start, and the key it plays untransposed at
+    int zoneIndex = SampleSlot::NO_ZONE;
+    int zoneRootKey = 60;
+
+    // Slice of the main zone played instead of its region (-1 = not slicing)
+    int sliceIndex = -1;
+
+    SlotState state;
+    SlotControl control;
+
+    // Stereo filter, LFO and granular engine for the slot
+    SVFilter filter;
+    LFO lfo;
+    GrainPlayer grainPlayer;
+
+    // Mod matrix output for the current control tick
+    const ModMatrix* modMatrix = nullptr;
+    ModMatrix::Destinations modulation {};
+    float modWheel = 0.0f;
 
     double currentSampleRate = 44100.0;
     int midiNote = 60;
@@ -66,9 +207,40 @@ private:
     bool isReversed = false;
     int octaveShift = 0;
 
-    // Control rate divider (update filters every N samples)
+    // Pitch wheel position (-1 to 1) and glide offset (semitones)
+    float pitchWheel = 0.0f;
+    float glideSemitones = 0.0f;
+    float glideStepPerSample = 0.0f;
+    int glideSourceNote = -1;
+    bool pitchRampPrimed = false;
+
+    // Silence floor as an envelope level: the floor divided by the loudest
+    // this note could be played (full slot volume x velocity)
+    float silenceFloorEnvelope = 0.0f;
+
+    // Control rate divider (update filters and pitch every N samples); a new
+    // divider takes over at the next tick so the current one runs out
     int controlRateCounter = 0;
-    static constexpr int CONTROL_RATE_DIVIDER = 32;
+    int controlRateDivider = CONTROL_RATE_DIVIDER;
+    int nextControlRateDivider = CONTROL_RATE_DIVIDER;
+
+    // Linear interpolation between frames, or the nearest earlier frame
+    bool interpolate = true;
+    int maxUnisonLanes = MAX_UNISON;
+
+    // Grains for one control-rate chunk are mixed here before the envelope
+    std::array<float, MAX_CONTROL_RATE_DIVIDER> grainBufferL {};
+    std::array<float, MAX_CONTROL_RATE_DIVIDER> grainBufferR {};
 
+    // Upper bound on frames prefetched per lane per block
+    static constexpr int MAX_PREFETCH_FRAMES = 4096;
+
+    // Root key when the voice has no zone
     static constexpr int ROOT_NOTE = 60;
+
+    // Slot volume at the top of its range
+    static inline const float MAX_SLOT_GAIN = juce::Decibels::decibelsToGain(Parameters::SLOT_VOLUME_MAX_DB);
+
+    // Pitch modulation at amount 1, in semitones
+    static constexpr float MOD_PITCH_RANGE = 12.0f;
 };
@@ -1,8 +1,14 @@
 #include "SampleSlot.h"
+#include "../DSP/OnsetDetector.h"
 
 SampleSlot::SampleSlot()
 {
     thumbnailData.resize(THUMBNAIL_POINTS, 0.0f);
+
+    retire(zones[0].publish(std::make_unique<Zone>()));
+
+    for (auto& table : zoneTables)
+        table.fill(TABLE_NO_ZONE);
 }
 
 bool SampleSlot::loadFromFile(const juce::File& file, juce::AudioFormatReader& reader, double targetSampleRate)
@@ -10,78 +16,620 @@ bool SampleSlot::loadFromFile(const juce::File& file, juce::AudioFormatReader& r
     if (reader.numChannels == 0 || reader.lengthInSamples == 0)
         return false;
 
-    sourceSampleRate = reader.sampleRate;
-    filePath = file.getFullPathName();
-    fileName = file.getFileName();
+    const juce::ScopedLock sl(freezeLock);
+    unfreeze();
+    ++loadGeneration;
 
-    // Read the audio data
-    juce::AudioBuffer<float> tempBuffer(static_cast<int>(reader.numChannels),
-                                         static_cast<int>(reader.lengthInSamples));
-    reader.read(&tempBuffer, 0, static_cast<int>(reader.lengthInSamples), 0, true, true);
+    numZones.store(0, std::memory_order_release);
+    compileZoneTable();
+    loaded = false;
+    instrumentPath.clear();
+
+    return addZone(file, reader, targetSampleRate, {});
+}
+
+bool SampleSlot::addZone(const juce::File& file, juce::AudioFormatReader& reader, double targetSampleRate,
+                         const ZoneMapping& mapping, double preloadSeconds)
+{
+    if (reader.numChannels == 0 || reader.lengthInSamples == 0)
+        return false;
+
+    const juce::ScopedLock sl(freezeLock);
+
+    int index = loaded ? getNumZones() : 0;
+    if (index >= MAX_ZONES)
+        return false;
+
+    if (index == 0)
+    {
+        unfreeze();
+        clearSlices();
+    }
+
+    // Another zone makes the slot more than its instrument file
+    instrumentPath.clear();
+
+    // Read into a new zone: the one it replaces may still be playing
+    auto newZone = std::make_unique<Zone>();
+    auto& zone = *newZone;
+    if (!readZone(zone, file, reader, targetSampleRate, preloadSeconds))
+        return false;
+
+    zone.mapping.lowKey = std::clamp(mapping.lowKey, 0, 127);
+    zone.mapping.highKey = std::clamp(mapping.highKey, zone.mapping.lowKey, 127);
+    zone.mapping.lowVelocity = std::clamp(mapping.lowVelocity, 0, 127);
+    zone.mapping.highVelocity = std::clamp(mapping.highVelocity, zone.mapping.lowVelocity, 127);
+    zone.mapping.rootKey = std::clamp(mapping.rootKey, 0, 127);
+
+    // Regions first, so a voice that finds the new zone also finds its region
+    {
+        const juce::ScopedLock rl(regionLock);
+        publishRegion(zone, index == 0 ? RegionSettings {} : regionSettings);
+    }
+
+    retire(zones[static_cast<size_t>(index)].publish(std::move(newZone)));
+
+    // Zones left over from the previous load
+    if (index == 0)
+        retireZonesFrom(1);
+
+    numZones.store(index + 1, std::memory_order_release);
+    compileZoneTable();
+
+    if (index == 0)
+    {
+        loaded = true;
+        fileName = file.getFileName();
+        generateThumbnail();
+
+        // Full-length region until the owner applies the slot's in/out settings
+        updatePlaybackRegion({});
+    }
+
+    return true;
+}
+
+bool SampleSlot::readZone(Zone& zone, const juce::File& file, juce::AudioFormatReader& reader,
+                          double targetSampleRate, double preloadSeconds) const
+{
+    zone.filePath = file.getFullPathName();
 
     // Resample if necessary
-    if (targetSampleRate > 0 && std::abs(sourceSampleRate - targetSampleRate) > 0.1)
+    bool resample = targetSampleRate > 0 && std::abs(reader.sampleRate - targetSampleRate) > 0.1;
+    zone.sampleRate = resample ? targetSampleRate : reader.sampleRate;
+
+    int sourceLength = static_cast<int>(reader.lengthInSamples);
+    int numFrames = resample ? static_cast<int>(std::ceil(sourceLength * (zone.sampleRate / reader.sampleRate)))
+                             : sourceLength;
+
+    // Full size up front; a preloaded zone leaves the rest silent
+    zone.audioData.setSize(static_cast<int>(reader.numChannels), numFrames, false, true, false);
+   #if OMNIVERSE_INTERLEAVED_SAMPLES
+    zone.interleavedData.allocate(numFrames);
+   #endif
+
+    int sourceFrames = sourceLength;
+    if (preloadSeconds > 0.0)
+        sourceFrames = std::clamp(static_cast<int>(preloadSeconds * reader.sampleRate), 2, sourceLength);
+
+    zone.pending = sourceFrames < sourceLength;
+    return readZoneFrames(zone, reader, sourceFrames);
+}
+
+bool SampleSlot::readZoneFrames(Zone& zone, juce::AudioFormatReader& reader, int sourceFrames) const
+{
+    // Read the audio data
+    juce::AudioBuffer<float> tempBuffer(static_cast<int>(reader.numChannels), sourceFrames);
+    if (!reader.read(&tempBuffer, 0, sourceFrames, 0, true, true))
+        return false;
+
+    auto& audioData = zone.audioData;
+    double ratio = zone.sampleRate / reader.sampleRate;
+    bool complete = sourceFrames >= static_cast<int>(reader.lengthInSamples);
+
+    // A partial read stops before frames that would interpolate past it
+    int numFrames = complete ? audioData.getNumSamples()
+                             : std::min(audioData.getNumSamples(), static_cast<int>((sourceFrames - 1) * ratio));
+
+    for (int channel = 0; channel < audioData.getNumChannels(); ++channel)
     {
-        double ratio = targetSampleRate / sourceSampleRate;
-        int newNumSamples = static_cast<int>(std::ceil(tempBuffer.getNumSamples() * ratio));
+        const float* inputData = tempBuffer.getReadPointer(channel);
+        float* outputData = audioData.getWritePointer(channel);
 
-        audioData.setSize(tempBuffer.getNumChannels(), newNumSamples);
+        if (ratio == 1.0)
+        {
+            juce::FloatVectorOperations::copy(outputData, inputData, numFrames);
+            continue;
+        }
 
-        for (int channel = 0; channel < tempBuffer.getNumChannels(); ++channel)
+        for (int i = 0; i < numFrames; ++i)
         {
-            const float* inputData = tempBuffer.getReadPointer(channel);
-            float* outputData = audioData.getWritePointer(channel);
+            double srcIndex = i / ratio;
+            int srcIndexInt = static_cast<int>(srcIndex);
+            float frac = static_cast<float>(srcIndex - srcIndexInt);
 
-            for (int i = 0; i < newNumSamples; ++i)
+            if (srcIndexInt + 1 < tempBuffer.getNumSamples())
+            {
+                outputData[i] = inputData[srcIndexInt] * (1.0f - frac)
+                              + inputData[srcIndexInt + 1] * frac;
+            }
+            else if (srcIndexInt < tempBuffer.getNumSamples())
             {
-                double srcIndex = i / ratio;
-                int srcIndexInt = static_cast<int>(srcIndex);
-                float frac = static_cast<float>(srcIndex - srcIndexInt);
-
-                if (srcIndexInt + 1 < tempBuffer.getNumSamples())
-                {
-                    outputData[i] = inputData[srcIndexInt] * (1.0f - frac)
-                                  + inputData[srcIndexInt + 1] * frac;
-                }
-                else if (srcIndexInt < tempBuffer.getNumSamples())
-                {
-                    outputData[i] = inputData[srcIndexInt];
-                }
-                else
-                {
-                    outputData[i] = 0.0f;
-                }
+                outputData[i] = inputData[srcIndexInt];
+            }
+            else
+            {
+                outputData[i] = 0.0f;
             }
         }
-
-        sourceSampleRate = targetSampleRate;
     }
-    else
+
+   #if OMNIVERSE_INTERLEAVED_SAMPLES
+    zone.interleavedData.write(audioData, 0, numFrames);
+   #endif
+
+    return true;
+}
+
+void SampleSlot::completePendingZones(juce::AudioFormatManager& formatManager, int generation)
+{
+    bool filledAny = false;
+
+    for (int z = 0; ; ++z)
     {
-        audioData = std::move(tempBuffer);
+        // One zone per lock, so a reload waits for at most one file read
+        const juce::ScopedLock sl(freezeLock);
+
+        if (loadGeneration.load() != generation || z >= getNumZones())
+            break;
+
+        const auto& zone = *zones[static_cast<size_t>(z)].get();
+        if (!zone.pending)
+            continue;
+
+        // Voices keep playing the preloaded head until the full zone, with
+        // its region already resolved, replaces it
+        juce::File file(zone.filePath);
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file));
+        auto filled = std::make_unique<Zone>();
+
+        if (reader == nullptr || reader->lengthInSamples == 0
+            || !readZone(*filled, file, *reader, zone.sampleRate, 0.0))
+            continue;
+
+        filled->mapping = zone.mapping;
+        {
+            const juce::ScopedLock rl(regionLock);
+            publishRegion(*filled, regionSettings);
+        }
+
+        retire(zones[static_cast<size_t>(z)].publish(std::move(filled)));
+        filledAny = true;
     }
 
-    loaded = true;
-    generateThumbnail();
+    const juce::ScopedLock sl(freezeLock);
 
-    return true;
+    if (filledAny && loadGeneration.load() == generation)
+        generateThumbnail();
+}
+
+void SampleSlot::setInstrumentFile(const juce::File& file)
+{
+    instrumentPath = file.getFullPathName();
+    fileName = file.getFileName();
 }
 
 void SampleSlot::clear()
 {
-    audioData.setSize(0, 0);
-    sourceSampleRate = 0.0;
+    const juce::ScopedLock sl(freezeLock);
+    unfreeze();
+    ++loadGeneration;
+
+    numZones.store(0, std::memory_order_release);
+    compileZoneTable();
+
+    retire(zones[0].publish(std::make_unique<Zone>()));
+    retireZonesFrom(1);
+
     loaded = false;
-    filePath.clear();
     fileName.clear();
-    std::fill(thumbnailData.begin(), thumbnailData.end(), 0.0f);
+    instrumentPath.clear();
+    clearSlices();
+    generateThumbnail();
+    updatePlaybackRegion({});
+}
+
+void SampleSlot::compileZoneTable()
+{
+    int inactive = 1 - activeZoneTable.load(std::memory_order_acquire);
+    auto& table = zoneTables[static_cast<size_t>(inactive)];
+    table.fill(TABLE_NO_ZONE);
+
+    // Later zones overwrite earlier ones where they overlap
+    int count = getNumZones();
+    for (int z = 0; z < count; ++z)
+    {
+        const auto& mapping = zones[static_cast<size_t>(z)].get()->mapping;
+
+        for (int key = mapping.lowKey; key <= mapping.highKey; ++key)
+        {
+            auto* row = table.data() + key * 128;
+            std::fill(row + mapping.lowVelocity, row + mapping.highVelocity + 1, static_cast<std::uint16_t>(z));
+        }
+    }
+
+    activeZoneTable.store(inactive, std::memory_order_release);
+}
+
+void SampleSlot::updatePlaybackRegion(const RegionSettings& settings)
+{
+    const juce::ScopedLock rl(regionLock);
+    regionSettings = settings;
+
+    // An empty slot still gets an (empty) region for its main zone
+    int count = loaded ? getNumZones() : 0;
+    for (int z = 0; z < std::max(count, 1); ++z)
+        publishRegion(*zones[static_cast<size_t>(z)].get(), settings);
+}
+
+void SampleSlot::publishRegion(const Zone& zone, const RegionSettings& settings)
+{
+    auto region = std::make_unique<PlaybackRegion>();
+    resolveRegion(zone, settings, *region);
+    retire(zone.region.publish(std::move(region)));
+}
+
+void SampleSlot::retire(std::unique_ptr<PlaybackRegion> region)
+{
+    const juce::ScopedLock rl(retiredLock);
+    retired.regions.push_back(std::move(region));
+}
+
+void SampleSlot::retireZonesFrom(int firstZone)
+{
+    for (int z = firstZone; z < MAX_ZONES && zones[static_cast<size_t>(z)].get() != nullptr; ++z)
+        retire(zones[static_cast<size_t>(z)].publish(nullptr));
+}
+
+void SampleSlot::retire(std::unique_ptr<Zone> zone)
+{
+    if (zone == nullptr)
+        return;
+
+    const juce::ScopedLock rl(retiredLock);
+    retired.zones.push_back(std::move(zone));
+}
+
+void SampleSlot::retire(std::unique_ptr<FrozenSample> sample)
+{
+    if (sample == nullptr)
+        return;
+
+    const juce::ScopedLock rl(retiredLock);
+    retired.frozenSamples.push_back(std::move(sample));
+}
+
+void SampleSlot::retire(std::unique_ptr<SliceSet> set)
+{
+    if (set == nullptr)
+        return;
+
+    const juce::ScopedLock rl(retiredLock);
+    retired.sliceSets.push_back(std::move(set));
+}
+
+SampleSlot::RetiredData SampleSlot::takeRetiredData()
+{
+    RetiredData taken;
+    const juce::ScopedLock rl(retiredLock);
+    std::swap(taken, retired);
+    return taken;
+}
+
+void SampleSlot::resolveRegion(const Zone& zone, const RegionSettings& settings, PlaybackRegion& region) const
+{
+    const auto& audioData = zone.audioData;
+    int numSamples = audioData.getNumSamples();
+
+    if (numSamples == 0)
+    {
+        region.inSample = 0;
+        region.outSample = 0;
+        region.length = 0;
+        region.forward.length = 0;
+        region.reverse.length = 0;
+        return;
+    }
+
+    // Ensure in < out with minimum 1% gap
+    float inPointPercent = settings.inPointPercent;
+    float outPointPercent = settings.outPointPercent;
+    if (outPointPercent <= inPointPercent + 1.0f)
+        outPointPercent = inPointPercent + 1.0f;
+
+    // Calculate sample positions for in/out points
+    int inSample = static_cast<int>((inPointPercent / 100.0f) * numSamples);
+    int outSample = static_cast<int>((outPointPercent / 100.0f) * numSamples);
+
+    // Clamp to valid range
+    inSample = std::clamp(inSample, 0, numSamples - 1);
+    outSample = std::clamp(outSample, inSample + 1, numSamples);
+
+    if (settings.snapToZeroCrossing)
+    {
+        // Search +/- 10ms around each point
+        int searchRadius = static_cast<int>(zone.sampleRate * 0.01);
+        inSample = findNearestZeroCrossing(audioData, inSample, searchRadius);
+        outSample = std::max(findNearestZeroCrossing(audioData, outSample, searchRadius), inSample + 1);
+    }
+
+    // Enforce minimum playable length (prevents clicks on tiny regions)
+    if (outSample - inSample < MIN_PLAYABLE_LENGTH)
+        outSample = std::min(inSample + MIN_PLAYABLE_LENGTH, numSamples);
+
+    region.inSample = inSample;
+    region.outSample = outSample;
+    region.length = outSample - inSample;
+
+    int crossfadeLength = static_cast<int>((settings.crossfadeMs / 1000.0f) * zone.sampleRate);
+    renderCrossfade(audioData, region.forward, region, crossfadeLength, false);
+    renderCrossfade(audioData, region.reverse, region, crossfadeLength, true);
+}
+
+int SampleSlot::findNearestZeroCrossing(const juce::AudioBuffer<float>& audioData, int targetSample, int searchRadius)
+{
+    int numSamples = audioData.getNumSamples();
+    int numChannels = audioData.getNumChannels();
+
+    // Sum of all channels, so a crossing is silent in every channel mix
+    auto sampleAt = [&](int index)
+    {
+        float sum = 0.0f;
+        for (int ch = 0; ch < numChannels; ++ch)
+            sum += audioData.getReadPointer(ch)[index];
+        return sum;
+    };
+
+    // Nearest first, a crossing between [i - 1] and [i] returns i
+    for (int offset = 0; offset <= searchRadius; ++offset)
+    {
+        for (int candidate : { targetSample - offset, targetSample + offset })
+        {
+            if (candidate < 1 || candidate >= numSamples)
+                continue;
+
+            float previous = sampleAt(candidate - 1);
+            float current = sampleAt(candidate);
+
+            if ((previous <= 0.0f && current >= 0.0f) || (previous >= 0.0f && current <= 0.0f))
+                return candidate;
+        }
+    }
+
+    return targetSample;
+}
+
+void SampleSlot::renderCrossfade(const juce::AudioBuffer<float>& audioData, CrossfadeTable& table,
+                                 const PlaybackRegion& region, int requestedLength, bool reversed)
+{
+    // Needs material before the loop start (in playback order) to fade in from
+    int preLoopAvailable = reversed ? audioData.getNumSamples() - region.outSample : region.inSample;
+    int length = std::min({ requestedLength, region.length / 2, preLoopAvailable });
+
+    if (length <= 0)
+    {
+        table.length = 0;
+        return;
+    }
+
+    table.data.setSize(audioData.getNumChannels(), length + 1, false, false, true);
+
+    for (int ch = 0; ch < audioData.getNumChannels(); ++ch)
+    {
+        const float* source = audioData.getReadPointer(ch);
+        float* dest = table.data.getWritePointer(ch);
+
+        for (int i = 0; i < length; ++i)
+        {
+            float t = static_cast<float>(i) / static_cast<float>(length);
+            float fadeOut = std::cos(t * juce::MathConstants<float>::halfPi);
+            float fadeIn = std::sin(t * juce::MathConstants<float>::halfPi);
+
+            float loopTail = reversed ? source[region.inSample + length - 1 - i]
+                                      : source[region.outSample - length + i];
+            float preLoop = reversed ? source[region.outSample - 1 + length - i]
+                                     : source[region.inSample - length + i];
+
+            dest[i] = loopTail * fadeOut + preLoop * fadeIn;
+        }
+
+        // Guard frame: the loop start the table wraps into
+        dest[length] = reversed ? source[region.outSample - 1] : source[region.inSample];
+    }
+
+    table.length = length;
+}
+
+void SampleSlot::renderFreeze(const FreezeSettings& settings)
+{
+    const juce::ScopedLock sl(freezeLock);
+
+    // Copied under the lock: the region may be replaced and reclaimed meanwhile
+    int inSample = 0;
+    int length = 0;
+    {
+        const juce::ScopedLock rl(regionLock);
+        inSample = getPlaybackRegion().inSample;
+        length = getPlaybackRegion().length;
+    }
+
+    if (!loaded || length == 0)
+        return;
+
+    auto rendered = std::make_unique<FrozenSample>();
+    auto& target = *rendered;
+
+    // Always stereo: the filter runs both channels together
+    target.data.setSize(2, length, false, false, true);
+
+    const auto& audioData = getAudioData();
+    const float* sourceL = audioData.getReadPointer(0) + inSample;
+    const float* sourceR = audioData.getNumChannels() >= 2 ? audioData.getReadPointer(1) + inSample : sourceL;
+    float* destL = target.data.getWritePointer(0);
+    float* destR = target.data.getWritePointer(1);
+
+    SVFilter filter;
+    LFO lfo;
+    filter.prepare(getSourceSampleRate());
+    lfo.prepare(getSourceSampleRate());
+    lfo.setRate(settings.lfoRate);
+    lfo.setWaveform(settings.lfoWaveform);
+
+    // The voice delays frozen audio like a bypassed filter, so the render
+    // drops the filter's own latency by running on past the end
+    const int latency = settings.filterBypass ? 0 : SVFilter::LATENCY;
+
+    for (int i = 0; i < length + latency; ++i)
+    {
+        // Same cutoff modulation and update rate as the live voice path
+        if (!settings.filterBypass && i % settings.controlInterval == 0)
+        {
+            float modulatedCutoff = settings.cutoffHz + lfo.getCurrentValue() * settings.cutoffHz * settings.lfoDepth;
+            filter.setParameters(settings.filterType, std::clamp(modulatedCutoff, 20.0f, 20000.0f), settings.resonance);
+        }
+
+        lfo.process();
+
+        float left = i < length ? sourceL[i] : 0.0f;
+        float right = i < length ? sourceR[i] : 0.0f;
+
+        if (!settings.filterBypass)
+            filter.process(left, right);
+
+        if (i >= latency)
+        {
+            destL[i - latency] = left;
+            destR[i - latency] = right;
+        }
+    }
+
+   #if OMNIVERSE_INTERLEAVED_SAMPLES
+    target.interleaved.build(target.data);
+   #endif
+
+    target.region.inSample = 0;
+    target.region.outSample = length;
+    target.region.length = length;
+    target.region.forward.length = 0;
+    target.region.reverse.length = 0;
+
+    retire(frozenSample.publish(std::move(rendered)));
+    frozen.store(true, std::memory_order_release);
+}
+
+void SampleSlot::detectSlices()
+{
+    const juce::ScopedLock sl(freezeLock);
+
+    const auto& audioData = getAudioData();
+    int numSamples = audioData.getNumSamples();
+    if (!loaded || numSamples == 0)
+        return;
+
+    // Detect on the channel sum
+    std::vector<float> mono(static_cast<size_t>(numSamples));
+    juce::FloatVectorOperations::copy(mono.data(), audioData.getReadPointer(0), numSamples);
+    for (int ch = 1; ch < audioData.getNumChannels(); ++ch)
+        juce::FloatVectorOperations::add(mono.data(), audioData.getReadPointer(ch), numSamples);
+
+    auto onsets = OnsetDetector::detect(mono.data(), numSamples, getSourceSampleRate());
+
+    // The first slice always starts at the top of the sample
+    std::vector<int> starts { 0 };
+    for (int onset : onsets)
+    {
+        if (onset - starts.back() >= MIN_PLAYABLE_LENGTH && static_cast<int>(starts.size()) < MAX_SLICES)
+            starts.push_back(onset);
+    }
+
+    auto detected = std::make_unique<SliceSet>();
+    auto& set = *detected;
+    set.count = static_cast<int>(starts.size());
+
+    for (size_t s = 0; s < starts.size(); ++s)
+    {
+        auto& region = set.regions[s];
+        region.inSample = starts[s];
+        region.outSample = s + 1 < starts.size() ? starts[s + 1] : numSamples;
+        region.length = region.outSample - region.inSample;
+        region.forward.length = 0;
+        region.reverse.length = 0;
+    }
+
+    retire(slices.publish(std::move(detected)));
+}
+
+void SampleSlot::clearSlices()
+{
+    retire(slices.publish(nullptr));
+}
+
+void SampleSlot::InterleavedBuffer::build(const juce::AudioBuffer<float>& source)
+{
+    allocate(source.getNumSamples());
+    write(source, 0, numFrames);
+}
+
+void SampleSlot::InterleavedBuffer::allocate(int frames)
+{
+    numFrames = frames;
+    data.assign(static_cast<size_t>(2 * (numFrames + 2 * GUARD_FRAMES)), 0.0f);
+}
+
+void SampleSlot::InterleavedBuffer::write(const juce::AudioBuffer<float>& source, int firstFrame, int count)
+{
+    count = std::min(count, numFrames - firstFrame);
+    if (count <= 0 || source.getNumChannels() == 0)
+        return;
+
+    const float* left = source.getReadPointer(0);
+    const float* right = source.getNumChannels() >= 2 ? source.getReadPointer(1) : left;
+    float* dest = data.data() + 2 * GUARD_FRAMES;
+
+    for (int i = firstFrame; i < firstFrame + count; ++i)
+    {
+        dest[2 * i] = left[i];
+        dest[2 * i + 1] = right[i];
+    }
+
+    // Guards repeat the edge frames, matching what the clamped reads returned
+    for (int g = 1; g <= GUARD_FRAMES; ++g)
+    {
+        if (firstFrame == 0)
+        {
+            dest[-2 * g] = left[0];
+            dest[-2 * g + 1] = right[0];
+        }
+
+        if (firstFrame + count == numFrames)
+        {
+            dest[2 * (numFrames - 1 + g)] = left[numFrames - 1];
+            dest[2 * (numFrames - 1 + g) + 1] = right[numFrames - 1];
+        }
+    }
 }
 
 void SampleSlot::generateThumbnail()
 {
+    const auto& audioData = getAudioData();
+
+    // Built off to the side: the message thread may be drawing the old one
+    std::vector<float> thumbnail(THUMBNAIL_POINTS, 0.0f);
+
     if (!loaded || audioData.getNumSamples() == 0)
     {
-        std::fill(thumbnailData.begin(), thumbnailData.end(), 0.0f);
+        const juce::ScopedLock tl(thumbnailLock);
+        thumbnailData.swap(thumbnail);
         return;
     }
 
@@ -106,6 +654,9 @@ void SampleSlot::generateThumbnail()
             }
         }
 
-        thumbnailData[i] = maxVal;
+        thumbnail[static_cast<size_t>(i)] = maxVal;
     }
+
+    const juce::ScopedLock tl(thumbnailLock);
+    thumbnailData.swap(thumbnail);
 }
@@ -2,36 +2,297 @@
 
 #include <juce_audio_basics/juce_audio_basics.h>
 #include <juce_audio_formats/juce_audio_formats.h>
+#include "../DSP/SVFilter.h"
+#include "../DSP/LFO.h"
+#include "../Utils/Published.h"
+
+// Keep an interleaved, guard-padded copy of each sample for the voice read loop
+#ifndef OMNIVERSE_INTERLEAVED_SAMPLES
+ #define OMNIVERSE_INTERLEAVED_SAMPLES 1
+#endif
 
 class SampleSlot
 {
 public:
+    // Settings the playback region is resolved from (parameter values)
+    struct RegionSettings
+    {
+        float inPointPercent = 0.0f;
+        float outPointPercent = 100.0f;
+        float crossfadeMs = 0.0f;
+        bool snapToZeroCrossing = false;
+    };
+
+    // Equal-power loop crossfade, rendered in playback order. Replaces the
+    // last `length` frames of the loop; frame [length] is a guard copy of the
+    // loop start so interpolation across the wrap needs no special case.
+    struct CrossfadeTable
+    {
+        int length = 0;
+        juce::AudioBuffer<float> data;
+    };
+
+    // In/out points resolved to sample indices, plus precomputed loop crossfades
+    struct PlaybackRegion
+    {
+        int inSample = 0;
+        int outSample = 0;
+        int length = 0;
+        CrossfadeTable forward;
+        CrossfadeTable reverse;
+    };
+
+    // Stereo frames stored LRLR (mono is duplicated) with edge copies on both
+    // sides, so interpolation may read one frame past either end unclamped
+    struct InterleavedBuffer
+    {
+        static constexpr int GUARD_FRAMES = 2;
+
+        std::vector<float> data;
+        int numFrames = 0;
+
+        void build(const juce::AudioBuffer<float>& source);
+        void clear() { data.clear(); numFrames = 0; }
+
+        // Sizes for numFrames silent frames; write() then fills them in place
+        void allocate(int frames);
+        void write(const juce::AudioBuffer<float>& source, int firstFrame, int count);
+
+        // Frame 0, i.e. past the leading guard
+        const float* frames() const { return data.data() + 2 * GUARD_FRAMES; }
+    };
+
+    // Filter and LFO settings a freeze is rendered with (parameter values)
+    struct FreezeSettings
+    {
+        SVFilter::Type filterType = SVFilter::Type::LowPass;
+        float cutoffHz = 20000.0f;
+        float resonance = 0.0f;
+        bool filterBypass = true;
+        float lfoRate = 1.0f;
+        float lfoDepth = 0.0f;
+        LFO::Waveform lfoWaveform = LFO::Waveform::Sine;
+        int controlInterval = 32;
+    };
+
+    // The region bounced through the filter and LFO at root pitch. Its own
+    // region covers the whole buffer, with no crossfades (no pre-loop audio).
+    struct FrozenSample
+    {
+        juce::AudioBuffer<float> data;
+        InterleavedBuffer interleaved;
+        PlaybackRegion region;
+    };
+
+    // Key and velocity range a zone answers to (inclusive, 0-127), and the key
+    // at which it plays untransposed
+    struct ZoneMapping
+    {
+        int lowKey = 0;
+        int highKey = 127;
+        int lowVelocity = 0;
+        int highVelocity = 127;
+        int rootKey = 60;
+    };
+
+    // One sample of the slot. The slot's in/out, loop and snap settings apply
+    // to every zone, each resolved against its own audio.
+    struct Zone
+    {
+        ZoneMapping mapping;
+        juce::AudioBuffer<float> audioData;
+        InterleavedBuffer interleavedData;
+        double sampleRate = 0.0;
+        juce::String filePath;
+
+        // Only the start has been read so far; the rest is silent until
+        // completePendingZones() fills it in
+        bool pending = false;
+
+        // Replaced whole whenever the slot's region settings change, which
+        // swaps the pointer but never writes the zone itself
+        mutable Published<PlaybackRegion> region { std::make_unique<PlaybackRegion>() };
+    };
+
+    static constexpr int MAX_ZONES = 1024;
+    static constexpr int NO_ZONE = -1;
+
+    // Slice mode maps consecutive keys from SLICE_BASE_KEY (C1) to consecutive
+    // transients of the main sample
+    static constexpr int SLICE_BASE_KEY = 36;
+    static constexpr int MAX_SLICES = 128 - SLICE_BASE_KEY;
+
+    struct SliceSet
+    {
+        std::array<PlaybackRegion, MAX_SLICES> regions;
+        int count = 0;
+    };
+
+    // Published objects a writer has replaced. A voice may still be reading
+    // one until the audio block in progress ends, so the slot's owner
+    // collects them and frees them once the audio thread has moved on.
+    struct RetiredData
+    {
+        std::vector<std::unique_ptr<PlaybackRegion>> regions;
+        std::vector<std::unique_ptr<FrozenSample>> frozenSamples;
+        std::vector<std::unique_ptr<SliceSet>> sliceSets;
+        std::vector<std::unique_ptr<Zone>> zones;
+
+        bool isEmpty() const { return regions.empty() && frozenSamples.empty() && sliceSets.empty() && zones.empty(); }
+    };
+
     SampleSlot();
     ~SampleSlot() = default;
 
+    // Replaces all zones with the file as a single zone covering every key and velocity
     bool loadFromFile(const juce::File& file, juce::AudioFormatReader& reader, double targetSampleRate);
+
+    // Adds the file as another zone; where zones overlap the later one wins.
+    // On an empty slot this becomes the first zone. With preloadSeconds > 0
+    // only that much is read now and the zone is left pending.
+    bool addZone(const juce::File& file, juce::AudioFormatReader& reader, double targetSampleRate,
+                 const ZoneMapping& mapping, double preloadSeconds = 0.0);
     void clear();
 
+    // Reads every pending zone in full into a new zone that replaces it
+    // (call from a background thread). Gives up once the slot is reloaded, cleared or cancelled after
+    // `generation` was taken.
+    void completePendingZones(juce::AudioFormatManager& formatManager, int generation);
+    void cancelPendingZones() { ++loadGeneration; }
+    int getLoadGeneration() const { return loadGeneration.load(); }
+
+    // Instrument file (e.g. .sfz) the zones came from; empty for a plain
+    // sample, and cleared by adding a zone (set it after the last one)
+    void setInstrumentFile(const juce::File& file);
+    juce::String getInstrumentPath() const { return instrumentPath; }
+
     bool isLoaded() const { return loaded; }
-    const juce::AudioBuffer<float>& getAudioData() const { return audioData; }
-    int getNumSamples() const { return audioData.getNumSamples(); }
-    int getNumChannels() const { return audioData.getNumChannels(); }
-    double getSourceSampleRate() const { return sourceSampleRate; }
-    juce::String getFilePath() const { return filePath; }
+    int getNumZones() const { return numZones.load(std::memory_order_acquire); }
+
+    // Zone 0 is the slot's main sample: the waveform, file name and freeze use it
+    const juce::AudioBuffer<float>& getAudioData() const { return getMainZone().audioData; }
+    const InterleavedBuffer& getInterleavedData() const { return getMainZone().interleavedData; }
+    int getNumSamples() const { return getAudioData().getNumSamples(); }
+    int getNumChannels() const { return getAudioData().getNumChannels(); }
+    double getSourceSampleRate() const { return getMainZone().sampleRate; }
+    juce::String getFilePath() const { return getMainZone().filePath; }
     juce::String getFileName() const { return fileName; }
 
-    // For waveform display
-    const std::vector<float>& getThumbnailData() const { return thumbnailData; }
+    // Zone for a note, in constant time from the compiled key/velocity table,
+    // or NO_ZONE when none covers it
+    int findZone(int key, int velocity) const
+    {
+        const auto& table = zoneTables[static_cast<size_t>(activeZoneTable.load(std::memory_order_acquire))];
+        int zone = table[static_cast<size_t>(std::clamp(key, 0, 127) * 128 + std::clamp(velocity, 0, 127))];
+        return zone == TABLE_NO_ZONE ? NO_ZONE : zone;
+    }
+
+    // nullptr once the index is beyond the loaded zones
+    const Zone* getZone(int index) const
+    {
+        return index >= 0 && index < getNumZones() ? zones[static_cast<size_t>(index)].get() : nullptr;
+    }
+
+    // Never null, empty while nothing is loaded
+    const Zone& getMainZone() const { return *zones[0].get(); }
+
+    // Rebuilds every zone's playback region off the audio thread and publishes them
+    void updatePlaybackRegion(const RegionSettings& settings);
+    const PlaybackRegion& getPlaybackRegion() const { return getPlaybackRegion(getMainZone()); }
+    const PlaybackRegion& getPlaybackRegion(const Zone& zone) const { return *zone.region.get(); }
+
+    // Everything replaced since the last call (any thread)
+    RetiredData takeRetiredData();
+
+    // Finds transients in the main sample and publishes the slices between
+    // them (call from a background thread). Slices are windows over the main
+    // zone's audio, so they share its buffer and have no loop crossfades.
+    void detectSlices();
+    int getNumSlices() const
+    {
+        const auto* set = slices.get();
+        return set != nullptr ? set->count : 0;
+    }
+
+    const PlaybackRegion* getSlice(int index) const
+    {
+        const auto* set = slices.get();
+        return set != nullptr && index >= 0 && index < set->count ? &set->regions[static_cast<size_t>(index)] : nullptr;
+    }
+
+    // Freeze renders the current region offline (call from a background
+    // thread); voices then play the frozen audio with their filter bypassed
+    void renderFreeze(const FreezeSettings& settings);
+    void unfreeze() { frozen.store(false, std::memory_order_release); }
+    bool isFrozen() const { return frozen.load(std::memory_order_acquire); }
+    // Null until the first freeze
+    const FrozenSample* getFrozenSample() const { return frozenSample.get(); }
+
+    // For waveform display; a copy, since a background zone fill may replace it
+    std::vector<float> getThumbnailData() const
+    {
+        const juce::ScopedLock tl(thumbnailLock);
+        return thumbnailData;
+    }
 
 private:
+    void clearSlices();
+
+    using ZoneTable = std::array<std::uint16_t, 128 * 128>;
+    static constexpr std::uint16_t TABLE_NO_ZONE = 0xFFFF;
+
+    bool readZone(Zone& zone, const juce::File& file, juce::AudioFormatReader& reader,
+                  double targetSampleRate, double preloadSeconds) const;
+    bool readZoneFrames(Zone& zone, juce::AudioFormatReader& reader, int sourceFrames) const;
+    void compileZoneTable();
+    void resolveRegion(const Zone& zone, const RegionSettings& settings, PlaybackRegion& region) const;
+    void publishRegion(const Zone& zone, const RegionSettings& settings);
+    void retireZonesFrom(int firstZone);
+    void retire(std::unique_ptr<PlaybackRegion> region);
+    void retire(std::unique_ptr<Zone> zone);
+    void retire(std::unique_ptr<FrozenSample> sample);
+    void retire(std::unique_ptr<SliceSet> set);
     void generateThumbnail();
+    static int findNearestZeroCrossing(const juce::AudioBuffer<float>& audio, int targetSample, int searchRadius);
+    static void renderCrossfade(const juce::AudioBuffer<float>& audio, CrossfadeTable& table,
+                                const PlaybackRegion& region, int requestedLength, bool reversed);
 
-    juce::AudioBuffer<float> audioData;
-    double sourceSampleRate = 0.0;
+    // A zone is never written once published: loading, reloading or clearing
+    // publishes a new one and retires the old one, which a voice may still be
+    // playing until its block ends. Zone 0 always exists.
+    std::array<Published<Zone>, MAX_ZONES> zones;
+    std::atomic<int> numZones { 0 };
     bool loaded = false;
-    juce::String filePath;
     juce::String fileName;
+    juce::String instrumentPath;
+
+    // Bumped by every reload so a background fill of pending zones stops
+    std::atomic<int> loadGeneration { 0 };
+
+    // Key * 128 + velocity -> zone index, double-buffered. A lookup reads a
+    // single entry, so one racing a recompile still gets some valid index,
+    // and getZone() checks it against the zones now loaded.
+    std::array<ZoneTable, 2> zoneTables;
+    std::atomic<int> activeZoneTable { 0 };
+
+    // The last settings are kept to resolve zones added later; the lock keeps
+    // region rebuilds apart and guards reading a region off the audio thread
+    RegionSettings regionSettings;
+    juce::CriticalSection regionLock;
+
+    RetiredData retired;
+    juce::CriticalSection retiredLock;
+
+    // Frozen audio and slices are published like the region (null when
+    // there are none); the lock keeps freeze renders, slicing, zone fills and
+    // reloads of the sample from overlapping (none run on the audio thread)
+    Published<FrozenSample> frozenSample;
+    Published<SliceSet> slices;
+    std::atomic<bool> frozen { false };
+    juce::CriticalSection freezeLock;
 
     std::vector<float> thumbnailData;
+    juce::CriticalSection thumbnailLock;
     static constexpr int THUMBNAIL_POINTS = 256;
+    static constexpr int MIN_PLAYABLE_LENGTH = 64;
 };
@@ -0,0 +1,219 @@
+#include "SfzParser.h"
+
+namespace
+{
+    using Opcodes = std::map<juce::String, juce::String>;
+
+    bool isOpcodeChar(juce::juce_wchar c)
+    {
+        return juce::CharacterFunctions::isLetterOrDigit(c) || c == '_';
+    }
+
+    // True if text[pos] starts "name=" or a header, i.e. ends the previous value
+    bool startsToken(const juce::String& text, int pos)
+    {
+        if (text[pos] == '<')
+            return true;
+
+        int end = pos;
+        while (isOpcodeChar(text[end]))
+            ++end;
+
+        return end > pos && text[end] == '=';
+    }
+
+    // Splits one line into headers and opcodes. Values run to the next token,
+    // so sample paths may contain spaces.
+    template <typename HeaderFn, typename OpcodeFn>
+    void tokeniseLine(const juce::String& line, HeaderFn&& onHeader, OpcodeFn&& onOpcode)
+    {
+        int length = line.length();
+        int pos = 0;
+
+        while (pos < length)
+        {
+            while (pos < length && juce::CharacterFunctions::isWhitespace(line[pos]))
+                ++pos;
+
+            if (pos >= length)
+                break;
+
+            if (line[pos] == '<')
+            {
+                int close = line.indexOfChar(pos, '>');
+                if (close < 0)
+                    break;
+
+                onHeader(line.substring(pos + 1, close).trim().toLowerCase());
+                pos = close + 1;
+                continue;
+            }
+
+            int equals = line.indexOfChar(pos, '=');
+            if (equals < 0)
+                break;
+
+            auto name = line.substring(pos, equals).trim();
+            int valueEnd = equals + 1;
+
+            while (valueEnd < length)
+            {
+                if (juce::CharacterFunctions::isWhitespace(line[valueEnd]))
+                {
+                    int next = valueEnd;
+                    while (next < length && juce::CharacterFunctions::isWhitespace(line[next]))
+                        ++next;
+
+                    if (next >= length || startsToken(line, next))
+                        break;
+
+                    valueEnd = next;
+                }
+                else if (line[valueEnd] == '<')
+                {
+                    break;
+                }
+                else
+                {
+                    ++valueEnd;
+                }
+            }
+
+            onOpcode(name, line.substring(equals + 1, valueEnd).trim());
+            pos = valueEnd;
+        }
+    }
+
+    int keyOpcode(const Opcodes& opcodes, const juce::String& name, int fallback)
+    {
+        auto it = opcodes.find(name);
+        if (it == opcodes.end())
+            return fallback;
+
+        int key = SfzParser::parseKey(it->second);
+        return key >= 0 ? key : fallback;
+    }
+
+    int intOpcode(const Opcodes& opcodes, const juce::String& name, int fallback)
+    {
+        auto it = opcodes.find(name);
+        return it != opcodes.end() ? it->second.getIntValue() : fallback;
+    }
+}
+
+int SfzParser::parseKey(const juce::String& text)
+{
+    auto value = text.trim().toLowerCase();
+    if (value.isEmpty())
+        return -1;
+
+    if (juce::CharacterFunctions::isDigit(value[0]))
+    {
+        int key = value.getIntValue();
+        return key <= 127 ? key : -1;
+    }
+
+    // Note name: letter, optional accidental, octave (c4 = 60)
+    static constexpr int semitones[] = { 9, 11, 0, 2, 4, 5, 7 }; // a b c d e f g
+    if (value[0] < 'a' || value[0] > 'g')
+        return -1;
+
+    int key = semitones[value[0] - 'a'];
+    int pos = 1;
+
+    if (value[pos] == '#')
+    {
+        ++key;
+        ++pos;
+    }
+    else if (value[pos] == 'b')
+    {
+        --key;
+        ++pos;
+    }
+
+    auto octaveText = value.substring(pos);
+    if (octaveText.isEmpty() || !octaveText.containsOnly("-0123456789"))
+        return -1;
+
+    key += (octaveText.getIntValue() + 1) * 12;
+    return key >= 0 && key <= 127 ? key : -1;
+}
+
+std::vector<SfzParser::Region> SfzParser::parse(const juce::File& sfzFile)
+{
+    std::vector<Region> regions;
+
+    juce::StringArray lines;
+    sfzFile.readLines(lines);
+
+    Opcodes control, global, master, group, region;
+    Opcodes* current = nullptr;
+    bool inRegion = false;
+
+    auto flushRegion = [&]()
+    {
+        if (!inRegion)
+            return;
+
+        inRegion = false;
+
+        // Inner levels override outer ones
+        Opcodes merged = global;
+        for (const auto* level : { &master, &group, &region })
+            for (const auto& [name, value] : *level)
+                merged[name] = value;
+
+        auto sample = merged.find("sample");
+        if (sample == merged.end() || sample->second.isEmpty())
+            return;
+
+        auto path = (control.count("default_path") ? control["default_path"] : juce::String())
+                  + sample->second;
+
+        Region result;
+        result.sample = sfzFile.getParentDirectory().getChildFile(path.replaceCharacter('\\', '/'));
+
+        auto& mapping = result.mapping;
+        int key = keyOpcode(merged, "key", -1);
+        mapping.lowKey = keyOpcode(merged, "lokey", key >= 0 ? key : 0);
+        mapping.highKey = keyOpcode(merged, "hikey", key >= 0 ? key : 127);
+        mapping.rootKey = keyOpcode(merged, "pitch_keycenter", key >= 0 ? key : 60);
+        mapping.lowVelocity = juce::jlimit(0, 127, intOpcode(merged, "lovel", 0));
+        mapping.highVelocity = juce::jlimit(0, 127, intOpcode(merged, "hivel", 127));
+
+        if (mapping.lowKey <= mapping.highKey && mapping.lowVelocity <= mapping.highVelocity)
+            regions.push_back(std::move(result));
+    };
+
+    auto onHeader = [&](const juce::String& header)
+    {
+        flushRegion();
+
+        if (header == "control")      { control.clear(); current = &control; }
+        else if (header == "global")  { global.clear(); master.clear(); group.clear(); current = &global; }
+        else if (header == "master")  { master.clear(); group.clear(); current = &master; }
+        else if (header == "group")   { group.clear(); current = &group; }
+        else if (header == "region")  { region.clear(); current = &region; inRegion = true; }
+        else                          { current = nullptr; } // <curve>, <effect>, ...
+    };
+
+    auto onOpcode = [&](const juce::String& name, const juce::String& value)
+    {
+        if (current != nullptr)
+            (*current)[name] = value;
+    };
+
+    for (auto line : lines)
+    {
+        // #define / #include aren't supported
+        line = line.upToFirstOccurrenceOf("//", false, false);
+        if (line.trimStart().startsWithChar('#'))
+            continue;
+
+        tokeniseLine(line, onHeader, onOpcode);
+    }
+
+    flushRegion();
+    return regions;
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include "SampleSlot.h"
+
+// Minimal SFZ reader: turns <region>s into slot zones. Understands the
+// <control>/<global>/<master>/<group>/<region> hierarchy and the sample,
+// default_path, key, lokey, hikey, lovel, hivel and pitch_keycenter opcodes;
+// everything else is ignored.
+namespace SfzParser
+{
+    struct Region
+    {
+        juce::File sample;
+        SampleSlot::ZoneMapping mapping;
+    };
+
+    std::vector<Region> parse(const juce::File& sfzFile);
+
+    // MIDI key from a number or a note name ("c4" = 60, "f#3", "eb-1"), or -1
+    int parseKey(const juce::String& text);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <vector>
+#include <juce_core/juce_core.h>
+#include "SampleSlot.h"
+#include "../Utils/Parameters.h"
+
+// A full set of slots that MIDI program changes switch between. The sampler
+// plays from one bank at a time; each voice holds on to the bank it started
+// in until it finishes, so a bank can be swapped out under ringing notes and
+// freed once they have all ended.
+class SlotBank
+{
+public:
+    // A zone of a slot that was built zone by zone
+    struct ZoneFile
+    {
+        juce::File file;
+        SampleSlot::ZoneMapping mapping;
+    };
+
+    // What a bank is built from: one file per slot (.sfz included, empty =
+    // unused), or for a slot built zone by zone, its zones in order
+    struct Definition
+    {
+        juce::String name;
+        std::array<juce::File, Parameters::NUM_SLOTS> files;
+        std::array<std::vector<ZoneFile>, Parameters::NUM_SLOTS> zones;
+
+        // Warm banks stay loaded so switching to them is instant
+        bool warm = false;
+    };
+
+    SlotBank() = default;
+    explicit SlotBank(const juce::String& bankName) : name(bankName) {}
+
+    SampleSlot* getSlot(int index)
+    {
+        return index >= 0 && index < Parameters::NUM_SLOTS ? &slots[static_cast<size_t>(index)] : nullptr;
+    }
+
+    const SampleSlot* getSlot(int index) const
+    {
+        return index >= 0 && index < Parameters::NUM_SLOTS ? &slots[static_cast<size_t>(index)] : nullptr;
+    }
+
+    const juce::String& getName() const { return name; }
+
+    // Voices playing from this bank; counted on the audio thread
+    void acquire() { voiceCount.fetch_add(1, std::memory_order_relaxed); }
+    void release() { voiceCount.fetch_sub(1, std::memory_order_release); }
+    bool hasVoices() const { return voiceCount.load(std::memory_order_acquire) > 0; }
+
+private:
+    std::array<SampleSlot, Parameters::NUM_SLOTS> slots;
+    juce::String name;
+    std::atomic<int> voiceCount { 0 };
+
+    JUCE_DECLARE_NON_COPYABLE(SlotBank)
+};
@@ -494,6 +494,53 @@ void SpectralFilterSection::resized()
 EffectsPanel::EffectsPanel(OmniverseAudioProcessor& processor)
     : processorRef(processor)
 {
+    auto& apvts = processorRef.getAPVTS();
+
+    chainLabel.setText("chain", juce::dontSendNotification);
+    chainLabel.setFont(juce::Font(14.0f, juce::Font::bold));
+    chainLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+    addAndMakeVisible(chainLabel);
+
+    // Items straight from the parameters' choices, ids from 1
+    auto setupBox = [this, &apvts](juce::ComboBox& box, const juce::String& paramId,
+                                   std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>& attachment)
+    {
+        if (auto* choice = dynamic_cast<juce::AudioParameterChoice*>(apvts.getParameter(paramId)))
+            box.addItemList(choice->choices, 1);
+
+        box.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF1A1A1A));
+        box.setColour(juce::ComboBox::textColourId, juce::Colours::white);
+        box.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xFF3A3A3A));
+        addAndMakeVisible(box);
+        attachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(apvts, paramId, box);
+    };
+
+    setupBox(chainBox, Parameters::EFFECT_CHAIN, chainAttachment);
+    setupBox(orderBox, Parameters::EFFECT_ORDER, orderAttachment);
+
+    const std::array<juce::String, NUM_BRANCHES> branchIds { Parameters::DELAY_BRANCH_LEVEL, Parameters::CHORUS_BRANCH_LEVEL,
+                                                              Parameters::TAPE_BRANCH_LEVEL, Parameters::SPECTRAL_BRANCH_LEVEL };
+    const std::array<juce::String, NUM_BRANCHES> branchNames { "delay level", "chorus level", "tape level", "spectral level" };
+
+    for (size_t i = 0; i < branchIds.size(); ++i)
+    {
+        auto& slider = branchLevelSliders[i];
+        slider.setSliderStyle(juce::Slider::LinearBar);
+        slider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 55, 18);
+        slider.setColour(juce::Slider::textBoxTextColourId, juce::Colours::white);
+        slider.setColour(juce::Slider::trackColourId, juce::Colour(0xFF3A3A3A));
+        slider.setColour(juce::Slider::backgroundColourId, juce::Colour(0xFF1A1A1A));
+        addAndMakeVisible(slider);
+        branchLevelAttachments[i] = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(
+            apvts, branchIds[i], slider);
+
+        auto& label = branchLevelLabels[i];
+        label.setText(branchNames[i], juce::dontSendNotification);
+        label.setFont(juce::Font(10.0f));
+        label.setColour(juce::Label::textColourId, juce::Colours::grey);
+        addAndMakeVisible(label);
+    }
+
     delaySection = std::make_unique<DelaySection>(processor);
     addAndMakeVisible(*delaySection);
 
@@ -516,6 +563,24 @@ void EffectsPanel::resized()
 {
     auto bounds = getLocalBounds().reduced(5);
 
+    // Chain bar: mode and custom order, then the parallel branch levels
+    auto chainRow = bounds.removeFromTop(30).reduced(3, 0);
+    chainLabel.setBounds(chainRow.removeFromLeft(50).withTrimmedTop(11));
+    chainBox.setBounds(chainRow.removeFromLeft(90).withTrimmedTop(8));
+    chainRow.removeFromLeft(5);
+    orderBox.setBounds(chainRow.removeFromLeft(220).withTrimmedTop(8));
+    chainRow.removeFromLeft(10);
+
+    int levelWidth = chainRow.getWidth() / NUM_BRANCHES;
+    for (size_t i = 0; i < branchLevelSliders.size(); ++i)
+    {
+        auto levelArea = chainRow.removeFromLeft(levelWidth).reduced(2, 0);
+        branchLevelLabels[i].setBounds(levelArea.removeFromTop(11));
+        branchLevelSliders[i].setBounds(levelArea);
+    }
+
+    bounds.removeFromTop(5);
+
     // 4 sections side by side
     int sectionWidth = bounds.getWidth() / 4;
 
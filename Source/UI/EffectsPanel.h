@@ -2,6 +2,7 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <array>
 
 class OmniverseAudioProcessor;
 
@@ -167,8 +168,20 @@ public:
     void resized() override;
 
 private:
+    static constexpr int NUM_BRANCHES = 4;
+
     OmniverseAudioProcessor& processorRef;
 
+    // Chain bar: serial/parallel/custom, the custom order and branch levels
+    juce::Label chainLabel;
+    juce::ComboBox chainBox;
+    juce::ComboBox orderBox;
+    std::array<juce::Slider, NUM_BRANCHES> branchLevelSliders;
+    std::array<juce::Label, NUM_BRANCHES> branchLevelLabels;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> chainAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> orderAttachment;
+    std::array<std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>, NUM_BRANCHES> branchLevelAttachments;
+
     // Effect sections
     std::unique_ptr<DelaySection> delaySection;
     std::unique_ptr<ChorusSection> chorusSection;
@@ -24,6 +24,7 @@ SlotFilterPanel::SlotFilterPanel(OmniverseAudioProcessor& processor, int index)
     filterTypeBox.addItem("Low Pass", 1);
     filterTypeBox.addItem("High Pass", 2);
     filterTypeBox.addItem("Band Pass", 3);
+    filterTypeBox.addItem("Ladder", 4);
     filterTypeBox.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF1A1A1A));
     filterTypeBox.setColour(juce::ComboBox::textColourId, juce::Colours::white);
     filterTypeBox.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xFF3A3A3A));
@@ -73,6 +74,52 @@ SlotFilterPanel::SlotFilterPanel(OmniverseAudioProcessor& processor, int index)
     addAndMakeVisible(lfoWaveformBox);
     lfoWaveformAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         apvts, Parameters::slotLfoWaveform(slotIndex), lfoWaveformBox);
+
+    // Unison section
+    unisonLabel.setText("unison", juce::dontSendNotification);
+    unisonLabel.setFont(juce::Font(11.0f));
+    unisonLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+    addAndMakeVisible(unisonLabel);
+
+    createSlider(unisonVoicesSlider, Parameters::slotUnisonVoices(slotIndex), unisonVoicesAttachment);
+    unisonVoicesSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 20);
+    createLabel(unisonVoicesLabel, "voices");
+
+    createSlider(unisonDetuneSlider, Parameters::slotUnisonDetune(slotIndex), unisonDetuneAttachment);
+    unisonDetuneSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 20);
+    createLabel(unisonDetuneLabel, "detune");
+
+    createSlider(unisonSpreadSlider, Parameters::slotUnisonSpread(slotIndex), unisonSpreadAttachment);
+    unisonSpreadSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 20);
+    createLabel(unisonSpreadLabel, "spread");
+
+    // Granular section
+    grainLabel.setText("grain", juce::dontSendNotification);
+    grainLabel.setFont(juce::Font(11.0f));
+    grainLabel.setColour(juce::Label::textColourId, juce::Colours::white);
+    addAndMakeVisible(grainLabel);
+
+    grainButton.setButtonText("GR");
+    grainButton.setClickingTogglesState(true);
+    grainButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF2A2A2A));
+    grainButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xFFFF006E));
+    grainButton.setColour(juce::TextButton::textColourOffId, juce::Colours::grey);
+    grainButton.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+    addAndMakeVisible(grainButton);
+    grainAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        apvts, Parameters::slotGranular(slotIndex), grainButton);
+
+    createSlider(grainSizeSlider, Parameters::slotGrainSize(slotIndex), grainSizeAttachment);
+    grainSizeSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 20);
+    createLabel(grainSizeLabel, "size");
+
+    createSlider(grainDensitySlider, Parameters::slotGrainDensity(slotIndex), grainDensityAttachment);
+    grainDensitySlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 20);
+    createLabel(grainDensityLabel, "density");
+
+    createSlider(grainScanSlider, Parameters::slotGrainScan(slotIndex), grainScanAttachment);
+    grainScanSlider.setTextBoxStyle(juce::Slider::TextBoxLeft, false, 30, 20);
+    createLabel(grainScanLabel, "scan");
 }
 
 void SlotFilterPanel::createSlider(juce::Slider& slider, const juce::String& paramId,
@@ -149,13 +196,54 @@ void SlotFilterPanel::resized()
     bounds.removeFromTop(5);
 
     lfoWaveformBox.setBounds(bounds.removeFromTop(22));
+    bounds.removeFromTop(5);
+
+    // Unison section (three compact columns)
+    unisonLabel.setBounds(bounds.removeFromTop(15));
+    bounds.removeFromTop(3);
+
+    auto unisonRow = bounds.removeFromTop(30);
+    int thirdWidth = unisonRow.getWidth() / 3;
+
+    auto voicesArea = unisonRow.removeFromLeft(thirdWidth).reduced(1, 0);
+    unisonVoicesLabel.setBounds(voicesArea.removeFromTop(12));
+    unisonVoicesSlider.setBounds(voicesArea);
+
+    auto detuneArea = unisonRow.removeFromLeft(thirdWidth).reduced(1, 0);
+    unisonDetuneLabel.setBounds(detuneArea.removeFromTop(12));
+    unisonDetuneSlider.setBounds(detuneArea);
+
+    auto spreadArea = unisonRow.reduced(1, 0);
+    unisonSpreadLabel.setBounds(spreadArea.removeFromTop(12));
+    unisonSpreadSlider.setBounds(spreadArea);
+    bounds.removeFromTop(5);
+
+    // Granular section (toggle in the header, three compact columns)
+    auto grainHeader = bounds.removeFromTop(15);
+    grainButton.setBounds(grainHeader.removeFromRight(30));
+    grainLabel.setBounds(grainHeader);
+    bounds.removeFromTop(3);
+
+    auto grainRow = bounds.removeFromTop(30);
+
+    auto sizeArea = grainRow.removeFromLeft(thirdWidth).reduced(1, 0);
+    grainSizeLabel.setBounds(sizeArea.removeFromTop(12));
+    grainSizeSlider.setBounds(sizeArea);
+
+    auto densityArea = grainRow.removeFromLeft(thirdWidth).reduced(1, 0);
+    grainDensityLabel.setBounds(densityArea.removeFromTop(12));
+    grainDensitySlider.setBounds(densityArea);
+
+    auto scanArea = grainRow.reduced(1, 0);
+    grainScanLabel.setBounds(scanArea.removeFromTop(12));
+    grainScanSlider.setBounds(scanArea);
 }
 
 // FiltersPanel implementation
 FiltersPanel::FiltersPanel(OmniverseAudioProcessor& processor)
     : processorRef(processor)
 {
-    for (int i = 0; i < 5; ++i)
+    for (int i = 0; i < Parameters::NUM_SLOTS; ++i)
     {
         slotPanels[i] = std::make_unique<SlotFilterPanel>(processor, i);
         addAndMakeVisible(*slotPanels[i]);
@@ -170,10 +258,23 @@ void FiltersPanel::paint(juce::Graphics& g)
 void FiltersPanel::resized()
 {
     auto bounds = getLocalBounds().reduced(5);
-    int panelWidth = bounds.getWidth() / 5;
+    int panelWidth = bounds.getWidth() / numVisibleSlots;
 
-    for (int i = 0; i < 5; ++i)
+    for (int i = firstVisibleSlot; i < firstVisibleSlot + numVisibleSlots; ++i)
     {
         slotPanels[i]->setBounds(bounds.removeFromLeft(panelWidth).reduced(3, 0));
     }
 }
+
+void FiltersPanel::showSlots(int firstSlot, int numSlots)
+{
+    firstVisibleSlot = juce::jlimit(0, Parameters::NUM_SLOTS - 1, firstSlot);
+    numVisibleSlots = juce::jlimit(1, Parameters::NUM_SLOTS - firstVisibleSlot, numSlots);
+
+    for (int i = 0; i < Parameters::NUM_SLOTS; ++i)
+    {
+        slotPanels[i]->setVisible(i >= firstVisibleSlot && i < firstVisibleSlot + numVisibleSlots);
+    }
+
+    resized();
+}
@@ -2,6 +2,7 @@
 
 #include <juce_gui_basics/juce_gui_basics.h>
 #include <juce_audio_processors/juce_audio_processors.h>
+#include "../Utils/Parameters.h"
 
 class OmniverseAudioProcessor;
 
@@ -42,6 +43,27 @@ private:
     juce::Label lfoRateLabel;
     juce::Label lfoDepthLabel;
 
+    // Unison controls
+    juce::Label unisonLabel;
+    juce::Slider unisonVoicesSlider;
+    juce::Slider unisonDetuneSlider;
+    juce::Slider unisonSpreadSlider;
+
+    juce::Label unisonVoicesLabel;
+    juce::Label unisonDetuneLabel;
+    juce::Label unisonSpreadLabel;
+
+    // Granular controls
+    juce::Label grainLabel;
+    juce::TextButton grainButton;
+    juce::Slider grainSizeSlider;
+    juce::Slider grainDensitySlider;
+    juce::Slider grainScanSlider;
+
+    juce::Label grainSizeLabel;
+    juce::Label grainDensityLabel;
+    juce::Label grainScanLabel;
+
     // Attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> filterTypeAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> cutoffAttachment;
@@ -50,6 +72,13 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> lfoRateAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> lfoDepthAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> lfoWaveformAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> unisonVoicesAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> unisonDetuneAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> unisonSpreadAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> grainAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> grainSizeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> grainDensityAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> grainScanAttachment;
 };
 
 class FiltersPanel : public juce::Component
@@ -60,7 +89,13 @@ public:
     void paint(juce::Graphics& g) override;
     void resized() override;
 
+    // Shows slots [firstSlot, firstSlot + numSlots) side by side and hides the rest
+    void showSlots(int firstSlot, int numSlots);
+
 private:
     OmniverseAudioProcessor& processorRef;
-    std::array<std::unique_ptr<SlotFilterPanel>, 5> slotPanels;
+    std::array<std::unique_ptr<SlotFilterPanel>, Parameters::NUM_SLOTS> slotPanels;
+
+    int firstVisibleSlot = 0;
+    int numVisibleSlots = Parameters::NUM_SLOTS;
 };
@@ -64,6 +64,56 @@ SlotPanel::SlotPanel(OmniverseAudioProcessor& processor, int index)
     loopAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
         processorRef.getAPVTS(), Parameters::slotLoop(slotIndex), loopButton);
 
+    // Loop mode
+    loopModeBox.addItem("fwd", 1);
+    loopModeBox.addItem("ping-pong", 2);
+    loopModeBox.setColour(juce::ComboBox::backgroundColourId, juce::Colour(0xFF1A1A1A));
+    loopModeBox.setColour(juce::ComboBox::textColourId, juce::Colours::white);
+    loopModeBox.setColour(juce::ComboBox::outlineColourId, juce::Colour(0xFF3A3A3A));
+    addAndMakeVisible(loopModeBox);
+    loopModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        processorRef.getAPVTS(), Parameters::slotLoopMode(slotIndex), loopModeBox);
+
+    // Loop crossfade
+    createSlider(loopCrossfadeSlider, Parameters::slotLoopCrossfade(slotIndex), loopCrossfadeAttachment);
+    loopCrossfadeSlider.setTextValueSuffix(" ms xf");
+
+    // Zero-crossing snap (same style as loop button)
+    loopSnapButton.setButtonText("ZC");
+    loopSnapButton.setClickingTogglesState(true);
+    loopSnapButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF2A2A2A));
+    loopSnapButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xFFFF006E));
+    loopSnapButton.setColour(juce::TextButton::textColourOffId, juce::Colours::grey);
+    loopSnapButton.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+    addAndMakeVisible(loopSnapButton);
+    loopSnapAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        processorRef.getAPVTS(), Parameters::slotLoopSnap(slotIndex), loopSnapButton);
+
+    // Freeze: lit while the slot plays its bounced audio
+    freezeButton.setButtonText("FRZ");
+    freezeButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF2A2A2A));
+    freezeButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xFF8B5CF6));
+    freezeButton.setColour(juce::TextButton::textColourOffId, juce::Colours::grey);
+    freezeButton.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+    freezeButton.onClick = [this]
+    {
+        if (processorRef.isSlotFrozen(slotIndex))
+            processorRef.unfreezeSlot(slotIndex);
+        else
+            processorRef.freezeSlot(slotIndex);
+    };
+    addAndMakeVisible(freezeButton);
+
+    sliceButton.setButtonText("SLC");
+    sliceButton.setClickingTogglesState(true);
+    sliceButton.setColour(juce::TextButton::buttonColourId, juce::Colour(0xFF2A2A2A));
+    sliceButton.setColour(juce::TextButton::buttonOnColourId, juce::Colour(0xFFFF006E));
+    sliceButton.setColour(juce::TextButton::textColourOffId, juce::Colours::grey);
+    sliceButton.setColour(juce::TextButton::textColourOnId, juce::Colours::white);
+    addAndMakeVisible(sliceButton);
+    sliceAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
+        processorRef.getAPVTS(), Parameters::slotSlice(slotIndex), sliceButton);
+
     // Update waveform display
     waveformDisplay.setSampleSlot(processorRef.getSampler().getSlot(slotIndex));
     waveformDisplay.setParameterReferences(&processorRef.getAPVTS(), slotIndex);
@@ -128,8 +178,12 @@ void SlotPanel::resized()
     // In/Out section (below waveform)
     auto inOutHeader = bounds.removeFromTop(14);
     int halfWidth = bounds.getWidth() / 2;
-    inOutLabel.setBounds(inOutHeader.removeFromLeft(halfWidth - 20));
     loopButton.setBounds(inOutHeader.removeFromRight(45).reduced(0, 0));
+    inOutHeader.removeFromRight(3);
+    freezeButton.setBounds(inOutHeader.removeFromRight(36));
+    inOutHeader.removeFromRight(3);
+    sliceButton.setBounds(inOutHeader.removeFromRight(32));
+    inOutLabel.setBounds(inOutHeader);
     bounds.removeFromTop(1);
 
     auto inOutRow = bounds.removeFromTop(26);
@@ -142,6 +196,14 @@ void SlotPanel::resized()
     outPointLabel.setBounds(outArea.removeFromTop(10));
     outPointSlider.setBounds(outArea.removeFromTop(14));
 
+    bounds.removeFromTop(2);
+
+    // Loop mode / crossfade / snap row
+    auto loopRow = bounds.removeFromTop(16);
+    loopModeBox.setBounds(loopRow.removeFromLeft(halfWidth).reduced(0, 1));
+    loopSnapButton.setBounds(loopRow.removeFromRight(28).reduced(0, 1));
+    loopCrossfadeSlider.setBounds(loopRow.reduced(2, 1));
+
     bounds.removeFromTop(4);
 
     // Volume and pitch row
@@ -194,7 +256,8 @@ bool SlotPanel::isInterestedInFileDrag(const juce::StringArray& files)
             file.endsWithIgnoreCase(".aiff") ||
             file.endsWithIgnoreCase(".mp3") ||
             file.endsWithIgnoreCase(".flac") ||
-            file.endsWithIgnoreCase(".ogg"))
+            file.endsWithIgnoreCase(".ogg") ||
+            file.endsWithIgnoreCase(".sfz"))
         {
             return true;
         }
@@ -246,4 +309,7 @@ void SlotPanel::timerCallback()
         float outPoint = processorRef.getAPVTS().getRawParameterValue(Parameters::slotOutPoint(slotIndex))->load();
         waveformDisplay.setInOutPoints(inPoint, outPoint);
     }
+
+    // Freeze renders finish in the background
+    freezeButton.setToggleState(processorRef.isSlotFrozen(slotIndex), juce::dontSendNotification);
 }
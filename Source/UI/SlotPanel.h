@@ -62,6 +62,18 @@ private:
     // Loop button (power button style)
     juce::TextButton loopButton;
 
+    // Loop mode, crossfade and zero-crossing snap
+    juce::ComboBox loopModeBox;
+    juce::Slider loopCrossfadeSlider;
+    juce::TextButton loopSnapButton;
+
+    // Freeze (not a parameter: bounces the slot, state comes from the processor)
+    juce::TextButton freezeButton;
+
+    // Slice mode: keys from C1 play the sample's transients
+    juce::TextButton sliceButton;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> sliceAttachment;
+
     // APVTS Attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> volumeAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> pitchAttachment;
@@ -72,6 +84,9 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> inPointAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> outPointAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> loopAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> loopModeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment> loopCrossfadeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> loopSnapAttachment;
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SlotPanel)
 };
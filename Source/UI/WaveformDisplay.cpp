@@ -140,7 +140,7 @@ void WaveformDisplay::paint(juce::Graphics& g)
         return;
     }
 
-    const auto& thumbnailData = sampleSlot->getThumbnailData();
+    const auto thumbnailData = sampleSlot->getThumbnailData();
     if (thumbnailData.empty())
         return;
 
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <atomic>
+#include <cmath>
+
+// Tracks how much of each block's time budget processing takes (elapsed time
+// / block duration) and steps a quality level up under sustained load, back
+// down once headroom returns. What each level gives up is the caller's
+// business; level 0 is full quality.
+//
+// Load is smoothed over a few blocks so a single slow block doesn't trigger a
+// change, and a change needs the load to stay past its threshold for a hold
+// time. The two thresholds are far apart, and recovering too eagerly (load
+// climbing straight back after a step up) doubles the recovery hold, so the
+// level doesn't flap at the edge.
+class CpuGovernor
+{
+public:
+    static constexpr int MAX_LEVEL = 4;
+
+    // One level change, for telemetry
+    struct Event
+    {
+        int fromLevel = 0;
+        int toLevel = 0;
+        float load = 0.0f;          // smoothed load that triggered it
+        double timeSeconds = 0.0;   // audio time since prepare()
+    };
+
+    void prepare(double newSampleRate)
+    {
+        sampleRate = newSampleRate;
+        clock = 0.0;
+        reset();
+    }
+
+    // Back to full quality without an event
+    void reset()
+    {
+        level.store(0, std::memory_order_relaxed);
+        smoothedLoad = 0.0f;
+        overTime = 0.0;
+        underTime = 0.0;
+        recoverHold = RECOVER_HOLD_SECONDS;
+        lastRecoverTime = -RELAPSE_WINDOW_SECONDS;
+    }
+
+    // Audio thread, once per block
+    void update(double elapsedSeconds, int numSamples)
+    {
+        if (numSamples <= 0 || sampleRate <= 0.0)
+            return;
+
+        double blockSeconds = numSamples / sampleRate;
+        float blockLoad = static_cast<float>(elapsedSeconds / blockSeconds);
+        float coefficient = static_cast<float>(1.0 - std::exp(-blockSeconds / SMOOTHING_SECONDS));
+
+        smoothedLoad += coefficient * (blockLoad - smoothedLoad);
+        load.store(smoothedLoad, std::memory_order_relaxed);
+        clock += blockSeconds;
+
+        if (smoothedLoad > DEGRADE_LOAD)
+        {
+            overTime += blockSeconds;
+            underTime = 0.0;
+        }
+        else if (smoothedLoad < RECOVER_LOAD)
+        {
+            underTime += blockSeconds;
+            overTime = 0.0;
+        }
+        else
+        {
+            overTime = 0.0;
+            underTime = 0.0;
+        }
+
+        int current = level.load(std::memory_order_relaxed);
+
+        if (overTime >= DEGRADE_HOLD_SECONDS && current < MAX_LEVEL)
+        {
+            // Overloaded again soon after recovering: wait longer next time
+            recoverHold = clock - lastRecoverTime < RELAPSE_WINDOW_SECONDS
+                        ? std::min(recoverHold * 2.0, MAX_RECOVER_HOLD_SECONDS)
+                        : RECOVER_HOLD_SECONDS;
+            changeLevel(current, current + 1);
+        }
+        else if (underTime >= recoverHold && current > 0)
+        {
+            lastRecoverTime = clock;
+            changeLevel(current, current - 1);
+        }
+    }
+
+    int getLevel() const { return level.load(std::memory_order_relaxed); }
+    float getLoad() const { return load.load(std::memory_order_relaxed); }
+
+    // Message thread: takes the oldest unread level change
+    bool popEvent(Event& event)
+    {
+        const auto scope = eventFifo.read(1);
+        if (scope.blockSize1 == 0)
+            return false;
+
+        event = events[static_cast<size_t>(scope.startIndex1)];
+        return true;
+    }
+
+private:
+    static constexpr float DEGRADE_LOAD = 0.8f;
+    static constexpr float RECOVER_LOAD = 0.5f;
+    static constexpr double SMOOTHING_SECONDS = 0.05;
+    static constexpr double DEGRADE_HOLD_SECONDS = 0.1;
+    static constexpr double RECOVER_HOLD_SECONDS = 2.0;
+    static constexpr double MAX_RECOVER_HOLD_SECONDS = 30.0;
+    static constexpr double RELAPSE_WINDOW_SECONDS = 5.0;
+    static constexpr int MAX_EVENTS = 32;
+
+    void changeLevel(int from, int to)
+    {
+        level.store(to, std::memory_order_relaxed);
+        overTime = 0.0;
+        underTime = 0.0;
+
+        // Dropped if nobody is reading
+        const auto scope = eventFifo.write(1);
+        if (scope.blockSize1 > 0)
+            events[static_cast<size_t>(scope.startIndex1)] = { from, to, smoothedLoad, clock };
+    }
+
+    double sampleRate = 0.0;
+    double clock = 0.0;
+    float smoothedLoad = 0.0f;
+    double overTime = 0.0;
+    double underTime = 0.0;
+    double recoverHold = RECOVER_HOLD_SECONDS;
+    double lastRecoverTime = -RELAPSE_WINDOW_SECONDS;
+
+    std::atomic<int> level { 0 };
+    std::atomic<float> load { 0.0f };
+
+    juce::AbstractFifo eventFifo { MAX_EVENTS };
+    std::array<Event, MAX_EVENTS> events {};
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+
+// The global effects and the orders they can run in. Kept apart from the
+// effect chain so parameter definitions can name them without the DSP.
+namespace EffectOrder
+{
+    enum Effect
+    {
+        Delay,
+        Chorus,
+        Tape,
+        Spectral,
+        NumEffects
+    };
+
+    using Order = std::array<std::uint8_t, NumEffects>;
+
+    constexpr Order DEFAULT_ORDER { Delay, Chorus, Tape, Spectral };
+
+    // Every order of the four effects, numbered in lexicographic order from
+    // the default Delay > Chorus > Tape > Spectral
+    constexpr int NUM_ORDERS = 24;
+
+    inline Order getOrder(int index)
+    {
+        Order order = DEFAULT_ORDER;
+        for (int i = std::clamp(index, 0, NUM_ORDERS - 1); i > 0; --i)
+            std::next_permutation(order.begin(), order.end());
+        return order;
+    }
+
+    inline const char* getEffectName(int effect)
+    {
+        static constexpr std::array<const char*, NumEffects> names { "Delay", "Chorus", "Tape", "Spectral" };
+        return effect >= 0 && effect < NumEffects ? names[static_cast<size_t>(effect)] : "";
+    }
+}
@@ -1,4 +1,5 @@
 #include "Parameters.h"
+#include "EffectOrder.h"
 
 namespace Parameters
 {
@@ -23,6 +24,13 @@ namespace Parameters
             juce::AudioParameterFloatAttributes().withLabel("%")
         ));
 
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(MORPH, 1),
+            "Morph",
+            juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f),
+            0.0f
+        ));
+
         // Playback mode parameters
         params.push_back(std::make_unique<juce::AudioParameterBool>(
             juce::ParameterID(PLAYBACK_LAYER, 1),
@@ -48,6 +56,37 @@ namespace Parameters
             false
         ));
 
+        // Pitch bend and glide parameters
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(PITCH_BEND_RANGE, 1),
+            "Pitch Bend Range",
+            juce::NormalisableRange<float>(0.0f, 24.0f, 1.0f),
+            2.0f,
+            juce::AudioParameterFloatAttributes().withLabel("st")
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(GLIDE_TIME, 1),
+            "Glide Time",
+            juce::NormalisableRange<float>(0.0f, 5000.0f, 1.0f, 0.3f),
+            0.0f,
+            juce::AudioParameterFloatAttributes().withLabel("ms")
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterFloat>(
+            juce::ParameterID(SILENCE_FLOOR, 1),
+            "Silence Floor",
+            juce::NormalisableRange<float>(-120.0f, -40.0f, 1.0f),
+            -90.0f,
+            juce::AudioParameterFloatAttributes().withLabel("dB")
+        ));
+
+        params.push_back(std::make_unique<juce::AudioParameterBool>(
+            juce::ParameterID(ADAPTIVE_QUALITY, 1),
+            "Adaptive Quality",
+            true
+        ));
+
         // Per-slot parameters
         for (int i = 0; i < NUM_SLOTS; ++i)
         {
@@ -57,7 +96,7 @@ namespace Parameters
             params.push_back(std::make_unique<juce::AudioParameterFloat>(
                 juce::ParameterID(slotVolume(i), 1),
                 slotPrefix + "Volume",
-                juce::NormalisableRange<float>(-60.0f, 12.0f, 0.1f),
+                juce::NormalisableRange<float>(-60.0f, SLOT_VOLUME_MAX_DB, 0.1f),
                 0.0f,
                 juce::AudioParameterFloatAttributes().withLabel("dB")
             ));
@@ -128,11 +167,92 @@ namespace Parameters
                 false
             ));
 
+            params.push_back(std::make_unique<juce::AudioParameterChoice>(
+                juce::ParameterID(slotLoopMode(i), 1),
+                slotPrefix + "Loop Mode",
+                juce::StringArray{"Forward", "Ping-Pong"},
+                0
+            ));
+
+            params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID(slotLoopCrossfade(i), 1),
+                slotPrefix + "Loop Crossfade",
+                juce::NormalisableRange<float>(0.0f, 500.0f, 1.0f, 0.4f),
+                10.0f,
+                juce::AudioParameterFloatAttributes().withLabel("ms")
+            ));
+
+            params.push_back(std::make_unique<juce::AudioParameterBool>(
+                juce::ParameterID(slotLoopSnap(i), 1),
+                slotPrefix + "Loop Snap",
+                false
+            ));
+
+            // Transient slices of the sample mapped to keys from C1
+            params.push_back(std::make_unique<juce::AudioParameterBool>(
+                juce::ParameterID(slotSlice(i), 1),
+                slotPrefix + "Slice",
+                false
+            ));
+
+            // Unison (stacked detuned copies of the slot)
+            params.push_back(std::make_unique<juce::AudioParameterInt>(
+                juce::ParameterID(slotUnisonVoices(i), 1),
+                slotPrefix + "Unison Voices",
+                1, 8, 1
+            ));
+
+            params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID(slotUnisonDetune(i), 1),
+                slotPrefix + "Unison Detune",
+                juce::NormalisableRange<float>(0.0f, 100.0f, 0.1f),
+                15.0f,
+                juce::AudioParameterFloatAttributes().withLabel("ct")
+            ));
+
+            params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID(slotUnisonSpread(i), 1),
+                slotPrefix + "Unison Spread",
+                juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
+                0.5f
+            ));
+
+            // Granular playback (grain pitch follows the note, scan sets speed)
+            params.push_back(std::make_unique<juce::AudioParameterBool>(
+                juce::ParameterID(slotGranular(i), 1),
+                slotPrefix + "Granular",
+                false
+            ));
+
+            params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID(slotGrainSize(i), 1),
+                slotPrefix + "Grain Size",
+                juce::NormalisableRange<float>(10.0f, 500.0f, 1.0f, 0.5f),
+                80.0f,
+                juce::AudioParameterFloatAttributes().withLabel("ms")
+            ));
+
+            params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID(slotGrainDensity(i), 1),
+                slotPrefix + "Grain Density",
+                juce::NormalisableRange<float>(1.0f, 100.0f, 0.1f, 0.5f),
+                20.0f,
+                juce::AudioParameterFloatAttributes().withLabel("Hz")
+            ));
+
+            params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID(slotGrainScan(i), 1),
+                slotPrefix + "Grain Scan",
+                juce::NormalisableRange<float>(0.0f, 2.0f, 0.01f),
+                1.0f,
+                juce::AudioParameterFloatAttributes().withLabel("x")
+            ));
+
             // Filter parameters (Phase 2 - registered now for APVTS completeness)
             params.push_back(std::make_unique<juce::AudioParameterChoice>(
                 juce::ParameterID(slotFilterType(i), 1),
                 slotPrefix + "Filter Type",
-                juce::StringArray{"Low Pass", "High Pass", "Band Pass"},
+                juce::StringArray{"Low Pass", "High Pass", "Band Pass", "Ladder"},
                 0
             ));
 
@@ -179,6 +299,33 @@ namespace Parameters
                 juce::StringArray{"Sine", "Triangle", "Square", "S&H"},
                 0
             ));
+
+            // Modulation matrix (choice order matches ModMatrix::Source / Destination)
+            for (int row = 0; row < MOD_ROWS; ++row)
+            {
+                auto rowPrefix = slotPrefix + "Mod " + juce::String(row + 1) + " ";
+
+                params.push_back(std::make_unique<juce::AudioParameterChoice>(
+                    juce::ParameterID(slotModSource(i, row), 1),
+                    rowPrefix + "Source",
+                    juce::StringArray{"Off", "LFO", "Velocity", "Envelope", "Note", "Mod Wheel"},
+                    0
+                ));
+
+                params.push_back(std::make_unique<juce::AudioParameterChoice>(
+                    juce::ParameterID(slotModDestination(i, row), 1),
+                    rowPrefix + "Destination",
+                    juce::StringArray{"Cutoff", "Pitch", "Volume", "Pan", "In Point"},
+                    0
+                ));
+
+                params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                    juce::ParameterID(slotModAmount(i, row), 1),
+                    rowPrefix + "Amount",
+                    juce::NormalisableRange<float>(-1.0f, 1.0f, 0.01f),
+                    0.0f
+                ));
+            }
         }
 
         // BBD Delay parameters (Phase 3)
@@ -348,6 +495,47 @@ namespace Parameters
             true
         ));
 
+        // Effect chain
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(EFFECT_CHAIN, 1),
+            "Effect Chain",
+            juce::StringArray{"Serial", "Parallel", "Custom"},
+            0
+        ));
+
+        juce::StringArray orderNames;
+        for (int i = 0; i < EffectOrder::NUM_ORDERS; ++i)
+        {
+            juce::StringArray names;
+            for (auto effect : EffectOrder::getOrder(i))
+                names.add(EffectOrder::getEffectName(effect));
+            orderNames.add(names.joinIntoString(" > "));
+        }
+
+        params.push_back(std::make_unique<juce::AudioParameterChoice>(
+            juce::ParameterID(EFFECT_ORDER, 1),
+            "Effect Order",
+            orderNames,
+            0
+        ));
+
+        const std::array<std::pair<juce::String, juce::String>, 4> branchLevels {{
+            { DELAY_BRANCH_LEVEL, "Delay Branch Level" },
+            { CHORUS_BRANCH_LEVEL, "Chorus Branch Level" },
+            { TAPE_BRANCH_LEVEL, "Tape Branch Level" },
+            { SPECTRAL_BRANCH_LEVEL, "Spectral Branch Level" }
+        }};
+
+        for (const auto& [id, name] : branchLevels)
+        {
+            params.push_back(std::make_unique<juce::AudioParameterFloat>(
+                juce::ParameterID(id, 1),
+                name,
+                juce::NormalisableRange<float>(0.0f, 1.0f, 0.01f),
+                1.0f
+            ));
+        }
+
         return { params.begin(), params.end() };
     }
 }
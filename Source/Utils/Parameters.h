@@ -1,6 +1,13 @@
 #pragma once
 
 #include <juce_audio_processors/juce_audio_processors.h>
+#include <bit>
+#include <cstdint>
+
+// Slot count, fixed at build time. 5, 16 and 32 are the supported values.
+#ifndef OMNIVERSE_NUM_SLOTS
+ #define OMNIVERSE_NUM_SLOTS 5
+#endif
 
 namespace Parameters
 {
@@ -8,12 +15,28 @@ namespace Parameters
     inline const juce::String MASTER_VOLUME = "master_volume";
     inline const juce::String STEREO_WIDTH = "stereo_width";
 
+    // Position between the stored A and B snapshots
+    inline const juce::String MORPH = "morph";
+
     // Playback mode parameters
     inline const juce::String PLAYBACK_LAYER = "playback_layer";
     inline const juce::String PLAYBACK_RANDOM = "playback_random";
     inline const juce::String RANDOM_OCTAVE = "random_octave";
     inline const juce::String REVERSE = "reverse";
 
+    // Pitch bend and glide parameters
+    inline const juce::String PITCH_BEND_RANGE = "pitch_bend_range";
+    inline const juce::String GLIDE_TIME = "glide_time";
+
+    // Level below which a slot is treated as finished
+    inline const juce::String SILENCE_FLOOR = "silence_floor";
+
+    // Let the CPU governor lower render quality under load
+    inline const juce::String ADAPTIVE_QUALITY = "adaptive_quality";
+
+    // Top of the slot volume range
+    constexpr float SLOT_VOLUME_MAX_DB = 12.0f;
+
     // Slot parameter ID generators
     inline juce::String slotVolume(int slot) { return "slot_" + juce::String(slot) + "_volume"; }
     inline juce::String slotPitch(int slot) { return "slot_" + juce::String(slot) + "_pitch"; }
@@ -24,6 +47,21 @@ namespace Parameters
     inline juce::String slotInPoint(int slot) { return "slot_" + juce::String(slot) + "_in_point"; }
     inline juce::String slotOutPoint(int slot) { return "slot_" + juce::String(slot) + "_out_point"; }
     inline juce::String slotLoop(int slot) { return "slot_" + juce::String(slot) + "_loop"; }
+    inline juce::String slotLoopMode(int slot) { return "slot_" + juce::String(slot) + "_loop_mode"; }
+    inline juce::String slotLoopCrossfade(int slot) { return "slot_" + juce::String(slot) + "_loop_crossfade"; }
+    inline juce::String slotLoopSnap(int slot) { return "slot_" + juce::String(slot) + "_loop_snap"; }
+    inline juce::String slotSlice(int slot) { return "slot_" + juce::String(slot) + "_slice"; }
+
+    // Unison parameters
+    inline juce::String slotUnisonVoices(int slot) { return "slot_" + juce::String(slot) + "_unison_voices"; }
+    inline juce::String slotUnisonDetune(int slot) { return "slot_" + juce::String(slot) + "_unison_detune"; }
+    inline juce::String slotUnisonSpread(int slot) { return "slot_" + juce::String(slot) + "_unison_spread"; }
+
+    // Granular parameters
+    inline juce::String slotGranular(int slot) { return "slot_" + juce::String(slot) + "_granular"; }
+    inline juce::String slotGrainSize(int slot) { return "slot_" + juce::String(slot) + "_grain_size"; }
+    inline juce::String slotGrainDensity(int slot) { return "slot_" + juce::String(slot) + "_grain_density"; }
+    inline juce::String slotGrainScan(int slot) { return "slot_" + juce::String(slot) + "_grain_scan"; }
 
     // Filter parameters (Phase 2)
     inline juce::String slotFilterType(int slot) { return "slot_" + juce::String(slot) + "_filter_type"; }
@@ -36,6 +74,12 @@ namespace Parameters
     inline juce::String slotLfoDepth(int slot) { return "slot_" + juce::String(slot) + "_lfo_depth"; }
     inline juce::String slotLfoWaveform(int slot) { return "slot_" + juce::String(slot) + "_lfo_waveform"; }
 
+    // Modulation matrix rows: source (0 = off), destination and bipolar amount
+    constexpr int MOD_ROWS = 4;
+    inline juce::String slotModSource(int slot, int row) { return "slot_" + juce::String(slot) + "_mod_" + juce::String(row) + "_source"; }
+    inline juce::String slotModDestination(int slot, int row) { return "slot_" + juce::String(slot) + "_mod_" + juce::String(row) + "_destination"; }
+    inline juce::String slotModAmount(int slot, int row) { return "slot_" + juce::String(slot) + "_mod_" + juce::String(row) + "_amount"; }
+
     // BBD Delay parameters (Phase 3)
     inline const juce::String DELAY_TIME = "delay_time";
     inline const juce::String DELAY_FEEDBACK = "delay_feedback";
@@ -67,8 +111,39 @@ namespace Parameters
     inline const juce::String SPECTRAL_MIX = "spectral_mix";
     inline const juce::String SPECTRAL_BYPASS = "spectral_bypass";
 
-    // Number of slots
-    constexpr int NUM_SLOTS = 5;
+    // Effect chain: Serial (default order), Parallel or Custom (EFFECT_ORDER),
+    // and each effect's level as a parallel branch
+    inline const juce::String EFFECT_CHAIN = "effect_chain";
+    inline const juce::String EFFECT_ORDER = "effect_order";
+    inline const juce::String DELAY_BRANCH_LEVEL = "delay_branch_level";
+    inline const juce::String CHORUS_BRANCH_LEVEL = "chorus_branch_level";
+    inline const juce::String TAPE_BRANCH_LEVEL = "tape_branch_level";
+    inline const juce::String SPECTRAL_BRANCH_LEVEL = "spectral_branch_level";
+
+    // Number of slots; everything sized per slot (parameters, sampler, UI) derives from this
+    constexpr int NUM_SLOTS = OMNIVERSE_NUM_SLOTS;
+
+    // A set of slots, one bit per slot index
+    using SlotMask = std::uint32_t;
+    static_assert(NUM_SLOTS >= 1 && NUM_SLOTS <= 32, "Slot sets are 32-bit masks");
+
+    constexpr SlotMask slotBit(int index) { return SlotMask { 1 } << index; }
+    constexpr SlotMask ALL_SLOTS = NUM_SLOTS == 32 ? ~SlotMask { 0 } : slotBit(NUM_SLOTS) - 1;
+
+    // Slot index encoded in a "slot_<n>_..." parameter ID, or -1.
+    // Doesn't allocate, so it is safe from parameter callbacks on the audio thread.
+    inline int slotIndexFromParameterID(const juce::String& paramId)
+    {
+        if (!paramId.startsWith("slot_"))
+            return -1;
+
+        int index = 0;
+        int pos = 5;
+        for (; paramId[pos] >= '0' && paramId[pos] <= '9'; ++pos)
+            index = index * 10 + static_cast<int>(paramId[pos] - '0');
+
+        return pos > 5 ? index : -1;
+    }
 
     // Create the full parameter layout
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
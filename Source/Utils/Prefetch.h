@@ -0,0 +1,31 @@
+#pragma once
+
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+ #include <xmmintrin.h>
+#endif
+
+namespace Prefetch
+{
+    constexpr int CACHE_LINE_FLOATS = 64 / static_cast<int>(sizeof(float));
+
+    // Read hint for one cache line; a no-op where the compiler has no intrinsic
+    inline void line(const float* address)
+    {
+       #if defined(__GNUC__) || defined(__clang__)
+        __builtin_prefetch(address, 0, 1);
+       #elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        _mm_prefetch(reinterpret_cast<const char*>(address), _MM_HINT_T1);
+       #else
+        (void) address;
+       #endif
+    }
+
+    // Touches every cache line of data[first, last]
+    inline void range(const float* data, int first, int last)
+    {
+        for (int i = first; i <= last; i += CACHE_LINE_FLOATS)
+            line(data + i);
+
+        line(data + last);
+    }
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+// An object the audio thread reads through a pointer it takes afresh for
+// every block. Writers never touch a published object: publish() swaps in a
+// complete replacement and hands back the old one, which a voice may still
+// be reading until the block in progress ends, so the caller retires it
+// rather than freeing it (see SampleSlot::RetiredData).
+template <typename T>
+class Published
+{
+public:
+    Published() = default;
+    explicit Published(std::unique_ptr<T> initial) : current(initial.release()) {}
+    ~Published() { delete current.load(); }
+
+    // Any thread. Valid until the end of the caller's block (audio thread)
+    // or until the owner next reclaims retired objects (other threads).
+    const T* get() const { return current.load(); }
+
+    // Any thread, one writer at a time
+    [[nodiscard]] std::unique_ptr<T> publish(std::unique_ptr<T> replacement)
+    {
+        return std::unique_ptr<T>(current.exchange(replacement.release()));
+    }
+
+private:
+    std::atomic<T*> current { nullptr };
+
+    Published(const Published&) = delete;
+    Published& operator=(const Published&) = delete;
+};
@@ -0,0 +1,167 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <juce_audio_basics/juce_audio_basics.h>
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+// Two stored snapshots (A and B) of a fixed list of normalised parameter
+// values, and the values part way between them. The morph runs on the audio
+// thread: one vector lerp over the whole list whenever the position moves,
+// after which only the entries that actually changed are handed back to the
+// caller to apply.
+//
+// Snapshots are stored on the message thread and picked up by the audio
+// thread at its next process() through a try-lock, so it never waits. A
+// newly stored snapshot takes effect the next time the position moves.
+class SnapshotMorph
+{
+public:
+    static constexpr int A = 0;
+    static constexpr int B = 1;
+
+    // Message thread, before audio runs
+    void setSize(int numValues)
+    {
+        const juce::SpinLock::ScopedLockType lock(pendingLock);
+
+        size = numValues;
+        for (auto& snapshot : snapshots)
+            snapshot.assign(static_cast<size_t>(size), 0.0f);
+        stored = {};
+
+        start.assign(static_cast<size_t>(size), 0.0f);
+        difference.assign(static_cast<size_t>(size), 0.0f);
+        morphed.assign(static_cast<size_t>(size), 0.0f);
+        applied.assign(static_cast<size_t>(size), 0.0f);
+        ready = false;
+        lastPosition = -1.0f;
+        pending = false;
+        reapply = false;
+    }
+
+    // Message thread; values must hold setSize() entries
+    void store(int snapshot, const std::vector<float>& values)
+    {
+        if ((snapshot != A && snapshot != B) || static_cast<int>(values.size()) != size)
+            return;
+
+        const juce::SpinLock::ScopedLockType lock(pendingLock);
+        snapshots[static_cast<size_t>(snapshot)] = values;
+        stored[static_cast<size_t>(snapshot)] = true;
+        pending = true;
+    }
+
+    // Message thread, after loading state: both snapshots at once, and the
+    // morph is reapplied at the current position even if it hasn't moved
+    void restore(const std::vector<float>& a, const std::vector<float>& b)
+    {
+        if (static_cast<int>(a.size()) != size || static_cast<int>(b.size()) != size)
+            return;
+
+        const juce::SpinLock::ScopedLockType lock(pendingLock);
+        snapshots[A] = a;
+        snapshots[B] = b;
+        stored = { true, true };
+        pending = true;
+        reapply = true;
+    }
+
+    // Message thread: stops morphing until both snapshots are stored again
+    void clear()
+    {
+        const juce::SpinLock::ScopedLockType lock(pendingLock);
+        stored = {};
+        pending = true;
+        reapply = false;
+    }
+
+    // Message thread
+    bool hasSnapshot(int snapshot) const
+    {
+        return (snapshot == A || snapshot == B) && stored[static_cast<size_t>(snapshot)];
+    }
+
+    const std::vector<float>& getSnapshot(int snapshot) const
+    {
+        return snapshots[static_cast<size_t>(snapshot == B ? B : A)];
+    }
+
+    // Audio thread, once per block. Calls applyChange(index, normalisedValue)
+    // for every entry that differs from what was last applied.
+    template <typename ApplyChange>
+    void process(float position, ApplyChange&& applyChange)
+    {
+        takePendingSnapshots(position);
+
+        if (!ready || position == lastPosition)
+            return;
+
+        lastPosition = position;
+        juce::FloatVectorOperations::copy(morphed.data(), start.data(), size);
+        juce::FloatVectorOperations::addWithMultiply(morphed.data(), difference.data(), position, size);
+
+        for (int i = 0; i < size; ++i)
+        {
+            auto index = static_cast<size_t>(i);
+            if (morphed[index] != applied[index])
+            {
+                applied[index] = morphed[index];
+                applyChange(i, morphed[index]);
+            }
+        }
+    }
+
+private:
+    void takePendingSnapshots(float position)
+    {
+        const juce::SpinLock::ScopedTryLockType lock(pendingLock);
+        if (!lock.isLocked() || !pending)
+            return;
+
+        pending = false;
+        ready = stored[A] && stored[B];
+        if (!ready)
+        {
+            reapply = false;
+            return;
+        }
+
+        juce::FloatVectorOperations::copy(start.data(), snapshots[A].data(), size);
+        juce::FloatVectorOperations::subtract(difference.data(), snapshots[B].data(), snapshots[A].data(), size);
+
+        if (reapply)
+        {
+            // NaN compares unequal to everything, so every entry is applied
+            std::fill(applied.begin(), applied.end(), std::numeric_limits<float>::quiet_NaN());
+            lastPosition = -1.0f;
+            reapply = false;
+            return;
+        }
+
+        // Storing doesn't move anything; the current position becomes the
+        // baseline for the next change
+        juce::FloatVectorOperations::copy(applied.data(), start.data(), size);
+        juce::FloatVectorOperations::addWithMultiply(applied.data(), difference.data(), position, size);
+        lastPosition = position;
+    }
+
+    int size = 0;
+
+    // Written on the message thread under pendingLock
+    juce::SpinLock pendingLock;
+    std::array<std::vector<float>, 2> snapshots;
+    std::array<bool, 2> stored {};
+    bool pending = false;
+    bool reapply = false;
+
+    // Audio thread only
+    std::vector<float> start;
+    std::vector<float> difference;
+    std::vector<float> morphed;
+    std::vector<float> applied;
+    bool ready = false;
+    float lastPosition = -1.0f;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <juce_core/juce_core.h>
+#include <array>
+#include <utility>
+
+// Fixed-capacity single-producer / single-consumer queue of movable items.
+// Neither side locks or allocates; items are moved in and out of
+// preallocated storage, so handing over a unique_ptr passes ownership
+// without the consumer ever freeing anything it didn't pop.
+template <typename Item, int Capacity>
+class SpscFifo
+{
+public:
+    // Producer. Moves the item in and returns true, or returns false and
+    // leaves it untouched when the queue is full.
+    bool push(Item& item)
+    {
+        const auto scope = fifo.write(1);
+        if (scope.blockSize1 == 0)
+            return false;
+
+        items[static_cast<size_t>(scope.startIndex1)] = std::move(item);
+        return true;
+    }
+
+    // Consumer: moves the oldest item out
+    bool pop(Item& item)
+    {
+        const auto scope = fifo.read(1);
+        if (scope.blockSize1 == 0)
+            return false;
+
+        item = std::move(items[static_cast<size_t>(scope.startIndex1)]);
+        return true;
+    }
+
+    bool isEmpty() const { return fifo.getNumReady() == 0; }
+
+private:
+    // AbstractFifo keeps one slot free to tell full from empty
+    juce::AbstractFifo fifo { Capacity + 1 };
+    std::array<Item, Capacity + 1> items {};
+};
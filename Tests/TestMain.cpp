@@ -0,0 +1,19 @@
+#include <juce_core/juce_core.h>
+#include <juce_events/juce_events.h>
+
+// Runs every registered juce::UnitTest; the exit code is non-zero on any failure
+int main()
+{
+    // The parameter tree starts a timer, which needs a message manager
+    juce::ScopedJuceInitialiser_GUI juceInitialiser;
+
+    juce::UnitTestRunner runner;
+    runner.setAssertOnFailure(false);
+    runner.runAllTests();
+
+    int failures = 0;
+    for (int i = 0; i < runner.getNumResults(); ++i)
+        failures += runner.getResult(i)->failures;
+
+    return failures > 0 ? 1 : 0;
+}
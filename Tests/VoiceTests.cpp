@@ -0,0 +1,152 @@
+#include <juce_audio_formats/juce_audio_formats.h>
+#include <juce_audio_processors/juce_audio_processors.h>
+#include "Sampler/OmniverseSampler.h"
+
+namespace
+{
+    // Hosts the plugin's parameter layout without the rest of the processor
+    class ParameterHost : public juce::AudioProcessor
+    {
+    public:
+        ParameterHost() : apvts(*this, nullptr, "PARAMETERS", Parameters::createParameterLayout()) {}
+
+        const juce::String getName() const override { return "ParameterHost"; }
+        void prepareToPlay(double, int) override {}
+        void releaseResources() override {}
+        void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override {}
+        double getTailLengthSeconds() const override { return 0.0; }
+        bool acceptsMidi() const override { return true; }
+        bool producesMidi() const override { return false; }
+        juce::AudioProcessorEditor* createEditor() override { return nullptr; }
+        bool hasEditor() const override { return false; }
+        int getNumPrograms() override { return 1; }
+        int getCurrentProgram() override { return 0; }
+        void setCurrentProgram(int) override {}
+        const juce::String getProgramName(int) override { return {}; }
+        void changeProgramName(int, const juce::String&) override {}
+        void getStateInformation(juce::MemoryBlock&) override {}
+        void setStateInformation(const void*, int) override {}
+
+        // Sets a parameter from its real (not normalised) value
+        void set(const juce::String& paramId, float value)
+        {
+            auto* parameter = apvts.getParameter(paramId);
+            parameter->setValueNotifyingHost(parameter->convertTo0to1(value));
+        }
+
+        juce::AudioProcessorValueTreeState apvts;
+    };
+}
+
+class VoiceTests : public juce::UnitTest
+{
+public:
+    VoiceTests() : juce::UnitTest("Voice", "Omniverse") {}
+
+    void runTest() override
+    {
+        beginTest("A held note keeps sounding under a full-depth LFO on volume");
+        {
+            ParameterHost host;
+            OmniverseSampler sampler;
+            sampler.setAPVTS(&host.apvts);
+            prepare(sampler);
+            loadSine(sampler, host);
+
+            // LFO -> volume at depth 1 takes the gain through zero every cycle
+            host.set(Parameters::slotLoop(0), 1.0f);
+            host.set(Parameters::slotLfoRate(0), 5.0f);
+            host.set(Parameters::slotModSource(0, 0), 1.0f);
+            host.set(Parameters::slotModDestination(0, 0), static_cast<float>(ModMatrix::Volume));
+            host.set(Parameters::slotModAmount(0, 0), 1.0f);
+            sampler.invalidateModRouting(0);
+
+            sampler.noteOn(1, 60, 1.0f);
+            render(sampler, 2.0);
+
+            expect(countActiveVoices(sampler) == 1, "The held note's voice was freed");
+            expectGreaterThan(render(sampler, 0.5), 0.01f, "The held note went silent");
+
+            // Released, it still ends once its release has run
+            sampler.noteOff(1, 60, 0.0f, true);
+            render(sampler, 0.25);
+            expectEquals(countActiveVoices(sampler), 1, "The release was cut short");
+            render(sampler, 1.0);
+            expectEquals(countActiveVoices(sampler), 0, "The released voice never finished");
+        }
+    }
+
+private:
+    static constexpr double sampleRate = 48000.0;
+    static constexpr int blockSize = 32;
+
+    static void prepare(OmniverseSampler& sampler)
+    {
+        sampler.setCurrentPlaybackSampleRate(sampleRate);
+
+        for (int i = 0; i < sampler.getNumVoices(); ++i)
+            if (auto* voice = dynamic_cast<OmniverseVoice*>(sampler.getVoice(i)))
+                voice->prepareToPlay(sampleRate, blockSize);
+    }
+
+    // One second of a 220 Hz sine into slot 0, through a temporary WAV file
+    void loadSine(OmniverseSampler& sampler, ParameterHost& host)
+    {
+        juce::AudioBuffer<float> sine(1, static_cast<int>(sampleRate));
+        for (int i = 0; i < sine.getNumSamples(); ++i)
+            sine.setSample(0, i, 0.5f * std::sin(juce::MathConstants<float>::twoPi * 220.0f * static_cast<float>(i / sampleRate)));
+
+        juce::TemporaryFile file(".wav");
+        {
+            juce::WavAudioFormat wav;
+            std::unique_ptr<juce::OutputStream> stream = file.getFile().createOutputStream();
+            std::unique_ptr<juce::AudioFormatWriter> writer(wav.createWriterFor(stream.get(), sampleRate, 1, 24, {}, 0));
+            expect(writer != nullptr, "Couldn't write the test sample");
+            if (writer == nullptr)
+                return;
+
+            stream.release();
+            writer->writeFromAudioSampleBuffer(sine, 0, sine.getNumSamples());
+        }
+
+        juce::AudioFormatManager formatManager;
+        formatManager.registerBasicFormats();
+        std::unique_ptr<juce::AudioFormatReader> reader(formatManager.createReaderFor(file.getFile()));
+        expect(reader != nullptr && sampler.getSlot(0)->loadFromFile(file.getFile(), *reader, sampleRate),
+               "Couldn't load the test sample");
+
+        SampleSlot::RegionSettings region;
+        region.crossfadeMs = host.apvts.getRawParameterValue(Parameters::slotLoopCrossfade(0))->load();
+        sampler.getSlot(0)->updatePlaybackRegion(region);
+    }
+
+    // Renders in control-rate blocks as the processor does; returns the peak level
+    static float render(OmniverseSampler& sampler, double seconds)
+    {
+        juce::AudioBuffer<float> block(2, blockSize);
+        juce::MidiBuffer noMidi;
+        float peak = 0.0f;
+
+        for (int done = 0; done < static_cast<int>(seconds * sampleRate); done += blockSize)
+        {
+            block.clear();
+            sampler.compileModRouting();
+            sampler.renderNextBlock(block, noMidi, 0, blockSize);
+            peak = std::max(peak, block.getMagnitude(0, blockSize));
+        }
+
+        return peak;
+    }
+
+    static int countActiveVoices(OmniverseSampler& sampler)
+    {
+        int count = 0;
+        for (int i = 0; i < sampler.getNumVoices(); ++i)
+            if (sampler.getVoice(i)->isVoiceActive())
+                ++count;
+
+        return count;
+    }
+};
+
+static VoiceTests voiceTests;